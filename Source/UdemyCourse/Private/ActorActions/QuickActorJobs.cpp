@@ -0,0 +1,207 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ActorActions/QuickActorJobs.h"
+#include "DebugHeader.h"
+#include "Editor.h"
+#include "Subsystems/EditorActorSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "QuickActorActions"
+
+namespace QuickActorJobs
+{
+	/** One duplicate per step. Actors deleted while the job is queued or running are skipped */
+	class FDuplicateActorsJob : public FAssetJob
+	{
+	public:
+		FDuplicateActorsJob(const TArray<AActor*>& InSourceActors, int32 InNumDuplicates, const FVector& InOffsetDistance, const FRotator& InRandomRotation)
+			: FAssetJob(FText::Format(LOCTEXT("DuplicatingActors", "Duplicating {0} actor(s)"), InSourceActors.Num() * InNumDuplicates))
+			, NumDuplicates(InNumDuplicates)
+			, OffsetDistance(InOffsetDistance)
+			, RandomRotation(InRandomRotation)
+		{
+			for (AActor* SourceActor : InSourceActors)
+			{
+				SourceActors.Add(SourceActor);
+			}
+		}
+
+		virtual int32 Start() override
+		{
+			EditorActorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorActorSubsystem>() : nullptr;
+			return EditorActorSubsystem.IsValid() ? SourceActors.Num() * NumDuplicates : 0;
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			AActor* SourceActor = SourceActors[StepIndex / NumDuplicates].Get();
+
+			if (!SourceActor || !EditorActorSubsystem.IsValid())
+			{
+				return;
+			}
+
+			const FVector Offset = OffsetDistance * (StepIndex % NumDuplicates + 1);
+			AActor* DuplicatedActor = EditorActorSubsystem->DuplicateActor(SourceActor, SourceActor->GetWorld(), Offset);
+
+			if (!DuplicatedActor)
+			{
+				return;
+			}
+
+			if (!RandomRotation.IsZero())
+			{
+				// FRotator is in Pitch, Yaw, Roll
+				DuplicatedActor->AddActorLocalRotation(FRotator(
+					FMath::RandRange(0.f, static_cast<float>(RandomRotation.Pitch)),
+					FMath::RandRange(0.f, static_cast<float>(RandomRotation.Yaw)),
+					FMath::RandRange(0.f, static_cast<float>(RandomRotation.Roll))
+				));
+			}
+
+			DuplicatedActors.Add(DuplicatedActor);
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			TArray<AActor*> ActorsToSelect;
+
+			for (const TWeakObjectPtr<AActor>& DuplicatedActor : DuplicatedActors)
+			{
+				if (DuplicatedActor.IsValid())
+				{
+					ActorsToSelect.Add(DuplicatedActor.Get());
+				}
+			}
+
+			// Duplicates made before a cancel are kept and selected, the scheduler already reports the cancel itself
+			if (bCancelled)
+			{
+				UE_LOG(LogUdemyCourse, Log, TEXT("Actor duplication cancelled, %d of %d duplicate(s) created"), ActorsToSelect.Num(), SourceActors.Num() * NumDuplicates);
+			}
+			else if (ActorsToSelect.IsEmpty())
+			{
+				DebugHeader::ShowNotification(LOCTEXT("DuplicationFailed", "Duplication has failed with no duplicates created."), ELogVerbosity::Error);
+				return;
+			}
+
+			// Single selection update for all duplicates
+			if (EditorActorSubsystem.IsValid() && !ActorsToSelect.IsEmpty())
+			{
+				EditorActorSubsystem->SetSelectedLevelActors(ActorsToSelect);
+			}
+
+			if (bCancelled)
+			{
+				return;
+			}
+
+			DebugHeader::ShowNotification(FText::Format(LOCTEXT("DuplicationSucceeded", "Successfully duplicated {0} actor(s)."), ActorsToSelect.Num()));
+		}
+
+	private:
+		/** Weak, the level may change or the actors be deleted between frames */
+		TArray<TWeakObjectPtr<AActor>> SourceActors;
+		TArray<TWeakObjectPtr<AActor>> DuplicatedActors;
+		TWeakObjectPtr<UEditorActorSubsystem> EditorActorSubsystem;
+		int32 NumDuplicates;
+		FVector OffsetDistance;
+		FRotator RandomRotation;
+	};
+
+	/** One actor per step, the same random ranges as UQuickActorActionsWidget. Actors deleted meanwhile are skipped */
+	class FRandomizeActorsTransformJob : public FAssetJob
+	{
+	public:
+		FRandomizeActorsTransformJob(const TArray<AActor*>& InActors, const FActorRandomTransform& InRandomTransform)
+			: FAssetJob(FText::Format(LOCTEXT("RandomizingActors", "Randomizing {0} actor(s)"), InActors.Num()))
+			, RandomTransform(InRandomTransform)
+		{
+			for (AActor* Actor : InActors)
+			{
+				Actors.Add(Actor);
+			}
+		}
+
+		virtual int32 Start() override
+		{
+			return Actors.Num();
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			AActor* Actor = Actors[StepIndex].Get();
+
+			if (!Actor)
+			{
+				return;
+			}
+
+			if (!RandomTransform.MaxRotation.IsZero())
+			{
+				// FRotator is in Pitch, Yaw, Roll
+				Actor->AddActorLocalRotation(FRotator(
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxRotation.Pitch)),
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxRotation.Yaw)),
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxRotation.Roll))
+				));
+			}
+
+			if (!RandomTransform.MaxOffset.IsZero())
+			{
+				Actor->AddActorLocalOffset(FVector(
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxOffset.X)),
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxOffset.Y)),
+					FMath::RandRange(0.f, static_cast<float>(RandomTransform.MaxOffset.Z))
+				));
+			}
+
+			if (RandomTransform.bRandomizeScale)
+			{
+				Actor->SetActorRelativeScale3D(FVector(
+					FMath::RandRange(static_cast<float>(RandomTransform.ScaleMin.X), static_cast<float>(RandomTransform.ScaleMax.X)),
+					FMath::RandRange(static_cast<float>(RandomTransform.ScaleMin.Y), static_cast<float>(RandomTransform.ScaleMax.Y)),
+					FMath::RandRange(static_cast<float>(RandomTransform.ScaleMin.Z), static_cast<float>(RandomTransform.ScaleMax.Z))
+				));
+			}
+
+			++NumRandomized;
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			UE_LOG(LogUdemyCourse, Log, TEXT("Randomized the transform of %d of %d actor(s)"), NumRandomized, Actors.Num());
+
+			// The scheduler already reports the cancel
+			if (bCancelled)
+			{
+				return;
+			}
+
+			if (NumRandomized == 0)
+			{
+				DebugHeader::ShowNotification(LOCTEXT("NoActorsRandomized", "No actors left to randomize, they were deleted meanwhile."), ELogVerbosity::Warning);
+				return;
+			}
+
+			DebugHeader::ShowNotification(FText::Format(LOCTEXT("ActorsRandomized", "Randomized the transform of {0} actor(s)."), NumRandomized));
+		}
+
+	private:
+		/** Weak, the level may change or the actors be deleted between frames */
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		FActorRandomTransform RandomTransform;
+		int32 NumRandomized = 0;
+	};
+
+	TSharedRef<FAssetJob> MakeDuplicateActorsJob(const TArray<AActor*>& SourceActors, int32 NumDuplicates, const FVector& OffsetDistance, const FRotator& RandomRotation)
+	{
+		return MakeShared<FDuplicateActorsJob>(SourceActors, NumDuplicates, OffsetDistance, RandomRotation);
+	}
+
+	TSharedRef<FAssetJob> MakeRandomizeActorsTransformJob(const TArray<AActor*>& Actors, const FActorRandomTransform& RandomTransform)
+	{
+		return MakeShared<FRandomizeActorsTransformJob>(Actors, RandomTransform);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
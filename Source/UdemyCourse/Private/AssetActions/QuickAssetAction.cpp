@@ -1,11 +1,16 @@
 // Copyright MODogma. All Rights Reserved.
 
 #include "AssetActions/QuickAssetAction.h"
+#include "AssetActions/QuickAssetJobs.h"
 #include "DebugHeader.h"
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h" // Create assets from code
+#include "ProcessData/AssetBatchRename.h"
+#include "ProcessData/NamingConvention.h"
+#include "SlateWidgets/ReviewListWindow.h"
+#include "UdemyCourse.h"
 //#include "ObjectTools.h" // for ObjectTools::DeleteAssets()
 
 #define LOCTEXT_NAMESPACE "FQuickAssetAction" // Required for LOCTEXT() macro
@@ -19,86 +24,58 @@ void UQuickAssetAction::DuplicateAssets(int32 NumDuplicates)
 		return;
 	}
 
-	TArray<FAssetData> SelectedAssetData = UEditorUtilityLibrary::GetSelectedAssetData();
-	uint32 NumDuplicated = 0;
-
-	for (const FAssetData& AssetData : SelectedAssetData)
-	{
-		for (int32 i = 0; i < NumDuplicates; ++i)
-		{
-			const FString SourceAssetPath = AssetData.GetObjectPathString();
-			const FString DuplicatedAssetName = AssetData.AssetName.ToString() + FString::Printf(TEXT("_%d"), i + 1);
-			const FString TargetPathName = FPaths::Combine(AssetData.PackagePath.ToString(), DuplicatedAssetName);//TEXT("/Duplicated");
-
-			if (UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, TargetPathName))
-			{
-				UE_LOG(LogTemp, Log, TEXT("Asset duplicated"));
-				UEditorAssetLibrary::SaveAsset(TargetPathName);
-				++NumDuplicated;
-			}
-		}
-	}
-
-	if (NumDuplicated == 0)
-	{
-		DebugHeader::ShowNotification(LOCTEXT("DuplicatedAssetsNotification", "No duplicates created, check the code."), ELogVerbosity::Error);
-		return;
-	}
-
-	DebugHeader::ShowNotification(FText::Format(LOCTEXT("DuplicatedAssetsNotification", "Successfully duplicated {0} asset(s)!"), NumDuplicated));
+	// Queued and run over several frames, the editor stays usable while the duplicates are made
+	FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetJobScheduler()
+		.Enqueue(QuickAssetJobs::MakeDuplicateAssetsJob(UEditorUtilityLibrary::GetSelectedAssetData(), NumDuplicates));
 }
 
 void UQuickAssetAction::AddPrefixes()
 {
-	TArray<UObject*> SelectedObjects = UEditorUtilityLibrary::GetSelectedAssets();
-	uint32 Counter = 0;
+	// Asset data only, the class path is enough to find the rule so nothing is loaded to decide
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	FNamingConvention& NamingConvention = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetNamingConvention();
+	TArray<FAssetBatchRenameItem> AssetsToRename;
 
-	for (UObject* SelectedObject : SelectedObjects)
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		// Skip current object if it is not valid
-		if (!SelectedObject)
+		// Skip current asset if it is not valid
+		if (!SelectedAssetData.IsValid())
 		{
-			UE_LOG(LogUdemyCourse, Error, TEXT("Invalid data for SelectedObject %s, skipping."), *SelectedObject->GetPackage()->GetName());
+			UE_LOG(LogUdemyCourse, Error, TEXT("Invalid data for selected asset %s, skipping."), *SelectedAssetData.PackageName.ToString());
 			continue;
 		}
 
-		FString* PrefixFound = PrefixMap.Find(SelectedObject->GetClass());
-
-		// There is no prefix element in PrefixMap. It needs to be added for the class
-		if (!PrefixFound || PrefixFound->IsEmpty())
+		// Neither the class, any of its parents nor the folder has a rule. It needs to be added in the plugin settings
+		if (!NamingConvention.HasRule(SelectedAssetData))
 		{
-			DebugHeader::ShowNotification(FText::Format(LOCTEXT("PrefixFindFailed", "Failed to find prefix for asset class {0}, skipping."), FText::FromString(SelectedObject->GetClass()->GetName())), ELogVerbosity::Error);
+			DebugHeader::ShowNotification(FText::Format(LOCTEXT("PrefixFindFailed", "Failed to find a naming rule for asset class {0}, skipping."), FText::FromName(SelectedAssetData.AssetClassPath.GetAssetName())), ELogVerbosity::Error);
 			continue;
 		}
 
-		FString OldName = SelectedObject->GetName();
-		FString CurrentName = OldName; // Storing separately so OldName can be used for logging
-
-		// Prefix already exists, skip renaming
-		if (OldName.StartsWith(*PrefixFound))
+		// Name already conforms, skip renaming
+		if (NamingConvention.Validate(SelectedAssetData) == ENamingIssue::None)
 		{
-			UE_LOG(LogUdemyCourse, Warning, TEXT("%s already has a proper prefix, not adding."), *OldName);
+			UE_LOG(LogUdemyCourse, Warning, TEXT("%s already has a proper prefix, not adding."), *SelectedAssetData.AssetName.ToString());
 			continue;
 		}
 
-		// Remove M_ prefix and _Inst suffix from material instance class (default Epic naming).
-		// This should be extended for more prefixes and suffixes, like Texture_,_BaseColor, etc.
-		if (SelectedObject->IsA<UMaterialInstanceConstant>())
-		{
-			CurrentName.RemoveFromEnd(TEXT("_Inst"));
-			CurrentName.RemoveFromStart(TEXT("M_"));
-		}
+		// Strips the affixes the rule lists (e.g. Epic's M_ and _Inst on material instances) before adding its own
+		const FString NewName = NamingConvention.MakeConformingName(SelectedAssetData, SelectedAssetData.AssetName.ToString());
+		AssetsToRename.Add({SelectedAssetData, SelectedAssetData.PackagePath.ToString(), NewName});
+	}
 
-		// Build the new name and rename asset
-		const FString NewName = *PrefixFound + CurrentName;
-		UEditorUtilityLibrary::RenameAsset(SelectedObject, NewName);
-		UE_LOG(LogUdemyCourse, Log, TEXT("File renamed: %s->%s"), *OldName, *NewName);
-		++Counter;
+	// One rename and redirector fixup for the whole selection. Only assets that are actually renamed get loaded
+	const int32 NumRenamed = RenameAssetsInBatch(MoveTemp(AssetsToRename));
+
+	// Cancelled in the preview
+	if (NumRenamed == INDEX_NONE)
+	{
+		return;
 	}
 
-	if (Counter > 0)
+	if (NumRenamed > 0)
 	{
-		DebugHeader::ShowNotification(FText::Format(LOCTEXT("FinishedPrefixeRename", "Finished renaming {0} asset(s) with new prefix!"), FText::AsNumber(Counter)));
+		DebugHeader::ShowNotification(FText::Format(LOCTEXT("FinishedPrefixeRename", "Finished renaming {0} asset(s) with new prefix!"), FText::AsNumber(NumRenamed)));
 	}
 	else
 	{
@@ -176,72 +153,122 @@ void UQuickAssetAction::DeleteUnusedAssets(bool bInGetSelectedAssets)
 
 void UQuickAssetAction::FixUpAllRedirectors()
 {
-	TArray<UObjectRedirector*> RedirectorsToFix;
-
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	// Get content root path to get all redirector assets
-	Filter.PackagePaths.Emplace("/Game");
-	// Filter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName()) also works, but has slight overhead
-	Filter.ClassPaths.Emplace("/Script/CoreUObject.ObjectRedirector");
-	TArray<FAssetData> OutRedirectors;
-	// Fill OutRedirectors with filtered redirector assets
-	AssetRegistry.GetAssets(Filter, OutRedirectors);
-
-	for (const FAssetData& Redirector : OutRedirectors)
-	{
-		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(Redirector.GetAsset()))
-		{
-			RedirectorsToFix.Add(RedirectorToFix);
-			UE_LOG(LogUdemyCourse, Log, TEXT("Fixed up redirector: %s"), *Redirector.PackageName.ToString());
-		}
-	}
-
-	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-	// This spawns its own window. No need to show notification
-	AssetToolsModule.Get().FixupReferencers(RedirectorsToFix);
+	// A fixup that is still queued already covers this request
+	FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetJobScheduler()
+		.Enqueue(QuickAssetJobs::MakeFixUpRedirectorsJob());
 }
 
 void UQuickAssetAction::RenameSelection(bool bAddPrefixes, FString NewName)
 {
-	TArray<UObject*> SelectedAssets = UEditorUtilityLibrary::GetSelectedAssets();
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	FNamingConvention& NamingConvention = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetNamingConvention();
+	TArray<FAssetBatchRenameItem> AssetsToRename;
 	int32 Counter = 1;
 
-	// Iterate over all selected assets and rename
-	for (UObject* SelectedAsset : SelectedAssets)
+	// Iterate over all selected assets and collect the new names
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
 		// Skip current asset if invalid
-		if (!SelectedAsset)
+		if (!SelectedAssetData.IsValid())
 		{
-			UE_LOG(LogUdemyCourse, Error, TEXT("Invalid data for SelectedObject %s, skipping."), *SelectedAsset->GetPackage()->GetName());
+			UE_LOG(LogUdemyCourse, Error, TEXT("Invalid data for selected asset %s, skipping."), *SelectedAssetData.PackageName.ToString());
 			continue;
 		}
 
-		FString OldName = SelectedAsset->GetName();
 		FString FinalName = NewName + TEXT("_") + FString::FromInt(Counter);
 
+		// A prefix or suffix already typed into NewName isn't added a second time
 		if (bAddPrefixes)
 		{
-			FString* PrefixFound = PrefixMap.Find(SelectedAsset->GetClass());
+			FinalName = NamingConvention.MakeConformingName(SelectedAssetData, FinalName);
+		}
+
+		AssetsToRename.Add({SelectedAssetData, SelectedAssetData.PackagePath.ToString(), FinalName});
+		++Counter;
+	}
+
+	const int32 NumRenamed = RenameAssetsInBatch(MoveTemp(AssetsToRename));
+
+	if (NumRenamed == INDEX_NONE)
+	{
+		return;
+	}
+
+	DebugHeader::ShowNotification(FText::Format(LOCTEXT("RenameConfirmation", "Successfully renamed {0} assets!"), NumRenamed));
+}
+
+void UQuickAssetAction::ValidateNamingConvention()
+{
+	FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetJobScheduler()
+		.Enqueue(QuickAssetJobs::MakeValidateNamingConventionJob());
+}
+
+int32 UQuickAssetAction::RenameAssetsInBatch(TArray<FAssetBatchRenameItem> AssetsToRename)
+{
+	// Conflicts are resolved against the registry before anything is touched, instead of surfacing as failed renames
+	TArray<FString> RequestedNames;
+	const int32 NumToRename = FAssetBatchRename::ResolveNameConflicts(AssetsToRename, RequestedNames);
+
+	if (NumToRename == 0)
+	{
+		return 0;
+	}
+
+	// Before/after table, one row per item in the same order, so the confirmed indices map straight back
+	TArray<TArray<FString>> PreviewRows;
+	PreviewRows.Reserve(AssetsToRename.Num());
+	int32 NumConflicts = 0;
+
+	for (int32 Index = 0; Index < AssetsToRename.Num(); ++Index)
+	{
+		const FAssetBatchRenameItem& Item = AssetsToRename[Index];
+		FString Conflict;
+
+		if (RequestedNames[Index] != Item.NewName)
+		{
+			Conflict = FString::Printf(TEXT("%s is taken"), *RequestedNames[Index]);
+			++NumConflicts;
+		}
+
+		PreviewRows.Add({Item.AssetData.PackageName.ToString(), Item.NewPackagePath / Item.NewName, MoveTemp(Conflict)});
+	}
+
+	const TArray<int32> ConfirmedIndices = SReviewListWindow::Open(
+		LOCTEXT("RenamePreviewTitle", "Rename Preview"),
+		FText::Format(LOCTEXT("RenamePreviewMessage", "{0} asset(s) will be renamed, {1} of them to the next free name because the requested one is taken. Nothing is renamed until you confirm."), NumToRename, NumConflicts),
+		LOCTEXT("RenamePreviewConfirm", "Rename"),
+		{LOCTEXT("RenameBeforeColumn", "Before"), LOCTEXT("RenameAfterColumn", "After"), LOCTEXT("RenameConflictColumn", "Conflict")},
+		PreviewRows);
+
+	if (ConfirmedIndices.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
 
-			// Skip rename if proper prefix already exists
-			if (FinalName.StartsWith(*PrefixFound))
-			{
-				UE_LOG(LogUdemyCourse, Warning, TEXT("The proper prefix already exists for %s, skipping."), *OldName);
-				continue;
-			}
+	TArray<FAssetBatchRenameItem> ConfirmedItems;
+	ConfirmedItems.Reserve(ConfirmedIndices.Num());
 
-			FinalName = *PrefixFound + FinalName;
+	for (const int32 ItemIndex : ConfirmedIndices)
+	{
+		ConfirmedItems.Add(AssetsToRename[ItemIndex]);
+	}
+
+	const TArray<FAssetData> RenamedAssets = FAssetBatchRename::RenameAssets(ConfirmedItems, FText::Format(LOCTEXT("RenamingAssets", "Renaming {0} asset(s)..."), ConfirmedItems.Num()));
+
+	// Items are renamed in order, so the renamed assets are a subsequence of them
+	int32 ItemIndex = 0;
+
+	for (const FAssetData& RenamedAsset : RenamedAssets)
+	{
+		while (ConfirmedItems[ItemIndex].AssetData.PackageName != RenamedAsset.PackageName)
+		{
+			++ItemIndex;
 		}
 
-		UEditorUtilityLibrary::RenameAsset(SelectedAsset, *FinalName);
-		UE_LOG(LogUdemyCourse, Log, TEXT("File renamed: %s->%s"), *OldName, *FinalName);
-		++Counter;
+		UE_LOG(LogUdemyCourse, Log, TEXT("File renamed: %s->%s"), *RenamedAsset.AssetName.ToString(), *ConfirmedItems[ItemIndex].NewName);
 	}
 
-	DebugHeader::ShowNotification(FText::Format(LOCTEXT("RenameConfirmation", "Successfully renamed {0} assets!"), SelectedAssets.Num()));
+	return RenamedAssets.Num();
 }
 
 #undef LOCTEXT_NAMESPACE // Required for LOCTEXT() macro
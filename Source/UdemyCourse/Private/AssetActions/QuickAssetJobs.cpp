@@ -0,0 +1,335 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "AssetActions/QuickAssetJobs.h"
+#include "AssetActions/QuickMaterialWidget.h"
+#include "DebugHeader.h"
+#include "EditorAssetLibrary.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Engine/Texture2D.h"
+#include "FileHelpers.h" // UEditorLoadingAndSavingUtils
+#include "ProcessData/AssetWindowedExecutor.h"
+#include "ProcessData/NamingConvention.h"
+#include "Settings/UdemyCourseSettings.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define LOCTEXT_NAMESPACE "FQuickAssetAction"
+
+namespace QuickAssetJobs
+{
+	/**
+	 * One duplicate per step, saved together in a single bulk save at the end. Past the configured window size
+	 * the duplicates are saved and unloaded window by window instead, so memory doesn't grow with the count
+	 */
+	class FDuplicateAssetsJob : public FAssetJob
+	{
+	public:
+		FDuplicateAssetsJob(const TArray<FAssetData>& InSourceAssets, int32 InNumDuplicates)
+			: FAssetJob(FText::Format(LOCTEXT("DuplicatingAssets", "Duplicating {0} asset(s)"), InSourceAssets.Num() * InNumDuplicates))
+			, SourceAssets(InSourceAssets)
+			, NumDuplicates(InNumDuplicates)
+		{}
+
+		virtual int32 Start() override
+		{
+			const int32 NumSteps = SourceAssets.Num() * NumDuplicates;
+			WindowSize = FAssetWindowedExecutor::GetWindowSize(NumSteps);
+			PackagesToSave.Reserve(FMath::Min(NumSteps, WindowSize));
+			return NumSteps;
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			const FAssetData& AssetData = SourceAssets[StepIndex / NumDuplicates];
+			const FString DuplicatedAssetName = AssetData.AssetName.ToString() + FString::Printf(TEXT("_%d"), StepIndex % NumDuplicates + 1);
+			const FString TargetPathName = FPaths::Combine(AssetData.PackagePath.ToString(), DuplicatedAssetName);
+
+			// Duplicates are only created in memory here, saving them one by one would serialize in between every copy
+			if (UObject* DuplicatedAsset = UEditorAssetLibrary::DuplicateAsset(AssetData.GetObjectPathString(), TargetPathName))
+			{
+				PackagesToSave.Emplace(DuplicatedAsset->GetPackage());
+				++NumDuplicated;
+			}
+
+			if (PackagesToSave.Num() >= WindowSize && StepIndex + 1 < SourceAssets.Num() * NumDuplicates)
+			{
+				SavePackages(true);
+			}
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			// Duplicates made before a cancel are still saved, so no unsaved copies are left behind
+			SavePackages(bReleaseSavedPackages);
+
+			UE_LOG(LogUdemyCourse, Log, TEXT("Duplicated %d of %d requested asset(s)"), NumDuplicated, SourceAssets.Num() * NumDuplicates);
+
+			if (NumDuplicated == 0)
+			{
+				DebugHeader::ShowNotification(LOCTEXT("DuplicatedAssetsNotification", "No duplicates created, check the code."), ELogVerbosity::Error);
+				return;
+			}
+
+			DebugHeader::ShowNotification(FText::Format(LOCTEXT("DuplicatedAssetsNotification", "Successfully duplicated {0} asset(s)!"), NumDuplicated));
+		}
+
+	private:
+		void SavePackages(bool bRelease)
+		{
+			TArray<UPackage*> Packages;
+
+			for (const TStrongObjectPtr<UPackage>& Package : PackagesToSave)
+			{
+				Packages.Add(Package.Get());
+			}
+
+			// A single bulk save, source control is checked and the save dialog shown once for every package
+			if (!Packages.IsEmpty() && !UEditorLoadingAndSavingUtils::SavePackages(Packages, false))
+			{
+				UE_LOG(LogUdemyCourse, Error, TEXT("Not every duplicated asset could be saved"));
+			}
+
+			PackagesToSave.Reset();
+
+			// Once one window was released, every later one is too
+			if (bRelease)
+			{
+				bReleaseSavedPackages = true;
+				FAssetWindowedExecutor::ReleasePackages(Packages);
+			}
+		}
+
+		TArray<FAssetData> SourceAssets;
+		int32 NumDuplicates;
+		int32 NumDuplicated = 0;
+		int32 WindowSize = 0;
+		bool bReleaseSavedPackages = false;
+		/** Kept alive until the save, garbage may be collected between frames */
+		TArray<TStrongObjectPtr<UPackage>> PackagesToSave;
+	};
+
+	/** Loads one redirector per step, then fixes up all of them at once. Repeated requests coalesce */
+	class FFixUpRedirectorsJob : public FAssetJob
+	{
+	public:
+		FFixUpRedirectorsJob()
+			: FAssetJob(LOCTEXT("FixingUpRedirectors", "Fixing up redirectors"), TEXT("FixUpAllRedirectors"))
+		{}
+
+		virtual int32 Start() override
+		{
+			IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+			FARFilter Filter;
+			Filter.bRecursivePaths = true;
+			// Get content root path to get all redirector assets
+			Filter.PackagePaths.Emplace("/Game");
+			// Filter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName()) also works, but has slight overhead
+			Filter.ClassPaths.Emplace("/Script/CoreUObject.ObjectRedirector");
+			// Queried when the job starts rather than when it is queued, so it sees the redirectors of earlier jobs
+			AssetRegistry.GetAssets(Filter, Redirectors);
+
+			return Redirectors.Num();
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(Redirectors[StepIndex].GetAsset()))
+			{
+				RedirectorsToFix.Emplace(RedirectorToFix);
+				UE_LOG(LogUdemyCourse, Log, TEXT("Fixed up redirector: %s"), *Redirectors[StepIndex].PackageName.ToString());
+			}
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			if (bCancelled || RedirectorsToFix.IsEmpty())
+			{
+				return;
+			}
+
+			TArray<UObjectRedirector*> LoadedRedirectors;
+
+			for (const TStrongObjectPtr<UObjectRedirector>& RedirectorToFix : RedirectorsToFix)
+			{
+				LoadedRedirectors.Add(RedirectorToFix.Get());
+			}
+
+			FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+			// This spawns its own window. No need to show notification
+			AssetToolsModule.Get().FixupReferencers(LoadedRedirectors);
+		}
+
+	private:
+		TArray<FAssetData> Redirectors;
+		TArray<TStrongObjectPtr<UObjectRedirector>> RedirectorsToFix;
+	};
+
+	/** One asset name per step, straight from the registry. Repeated requests coalesce */
+	class FValidateNamingConventionJob : public FAssetJob
+	{
+	public:
+		FValidateNamingConventionJob()
+			: FAssetJob(LOCTEXT("ValidatingNamingConvention", "Validating asset names"), TEXT("ValidateNamingConvention"))
+		{}
+
+		virtual int32 Start() override
+		{
+			StartTime = FPlatformTime::Seconds();
+			IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+			FARFilter Filter;
+			Filter.bRecursivePaths = true;
+			Filter.PackagePaths.Emplace("/Game");
+			Filter.bIncludeOnlyOnDiskAssets = true;
+			AssetRegistry.GetAssets(Filter, AssetsData);
+
+			// A copy of its own, the module recompiles its convention whenever the settings change
+			NamingConvention = MakeUnique<FNamingConvention>(*GetDefault<UUdemyCourseSettings>());
+			return AssetsData.Num();
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			const FAssetData& AssetData = AssetsData[StepIndex];
+
+			if (AssetData.AssetClassPath == RedirectorPath || !NamingConvention->HasRule(AssetData))
+			{
+				return;
+			}
+
+			++NumChecked;
+			const ENamingIssue Issues = NamingConvention->Validate(AssetData);
+
+			if (Issues == ENamingIssue::None)
+			{
+				return;
+			}
+
+			if (++NumViolations <= MaxLoggedViolations)
+			{
+				UE_LOG(LogUdemyCourse, Warning, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *NamingConvention->DescribeIssues(AssetData, Issues));
+			}
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			if (NumViolations > MaxLoggedViolations)
+			{
+				UE_LOG(LogUdemyCourse, Warning, TEXT("... and %d more naming violation(s)"), NumViolations - MaxLoggedViolations);
+			}
+
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+			UE_LOG(LogUdemyCourse, Log, TEXT("Validated %d of %d asset name(s) in %.2fs, %d violation(s)"), NumChecked, AssetsData.Num(), ElapsedSeconds, NumViolations);
+
+			if (bCancelled)
+			{
+				return;
+			}
+
+			if (NumViolations == 0)
+			{
+				DebugHeader::ShowNotification(FText::Format(LOCTEXT("NamingConventionPassed", "All {0} checked asset(s) follow the naming convention."), NumChecked));
+				return;
+			}
+
+			DebugHeader::ShowNotification(FText::Format(LOCTEXT("NamingConventionFailed", "{0} of {1} checked asset(s) break the naming convention, see the output log."), NumViolations, NumChecked), ELogVerbosity::Warning);
+		}
+
+	private:
+		/** Lines written to the log, the rest is only counted so a badly named project doesn't flood it */
+		static constexpr int32 MaxLoggedViolations = 200;
+
+		const FTopLevelAssetPath RedirectorPath = UObjectRedirector::StaticClass()->GetClassPathName();
+		TArray<FAssetData> AssetsData;
+		TUniquePtr<FNamingConvention> NamingConvention;
+		double StartTime = 0.0;
+		int32 NumChecked = 0;
+		int32 NumViolations = 0;
+	};
+
+	/**
+	 * Builds one material with the settings of the material widget, one texture per step. Each step loads
+	 * its texture on its own, so a large selection is spread over frames instead of loaded up front
+	 */
+	class FCreateMaterialJob : public FAssetJob
+	{
+	public:
+		FCreateMaterialJob(UQuickMaterialWidget* InMaterialWidget, const TArray<FAssetData>& InTexturesData)
+			: FAssetJob(FText::Format(LOCTEXT("CreatingMaterial", "Creating a material from {0} texture(s)"), InTexturesData.Num()))
+			, MaterialWidget(InMaterialWidget)
+			, TexturesData(InTexturesData)
+		{}
+
+		virtual int32 Start() override
+		{
+			if (!MaterialWidget.IsValid() || !MaterialWidget->HasValidMaterialName())
+			{
+				return 0;
+			}
+
+			if (TexturesData.IsEmpty())
+			{
+				DebugHeader::ShowNotification(LOCTEXT("InvalidSelection", "A texture asset selection is required!"), ELogVerbosity::Warning);
+				return 0;
+			}
+
+			// The class and name are known from the asset data, so nothing is loaded before the material exists
+			for (const FAssetData& TextureData : TexturesData)
+			{
+				if (!TextureData.IsInstanceOf(UTexture2D::StaticClass()))
+				{
+					DebugHeader::ShowNotification(FText::Format(LOCTEXT("NotATexture", "'{0}' is not a texture, no material created."), FText::FromName(TextureData.AssetName)), ELogVerbosity::Warning);
+					return 0;
+				}
+			}
+
+			MaterialWidget->SetMaterialNameFromTexture(TexturesData[0].AssetName.ToString());
+			bStarted = MaterialWidget->BeginMaterialCreation(TexturesData[0].PackagePath.ToString());
+
+			return bStarted ? TexturesData.Num() : 0;
+		}
+
+		virtual void ProcessStep(int32 StepIndex) override
+		{
+			MaterialWidget->AddTextureToMaterial(Cast<UTexture2D>(TexturesData[StepIndex].GetAsset()));
+		}
+
+		virtual void Finish(bool bCancelled) override
+		{
+			if (bStarted)
+			{
+				MaterialWidget->FinishMaterialCreation(bCancelled);
+			}
+		}
+
+	private:
+		/** Holds the pending material, kept alive until the job is done even if the widget is closed */
+		TStrongObjectPtr<UQuickMaterialWidget> MaterialWidget;
+		TArray<FAssetData> TexturesData;
+		bool bStarted = false;
+	};
+
+	TSharedRef<FAssetJob> MakeDuplicateAssetsJob(const TArray<FAssetData>& SourceAssets, int32 NumDuplicates)
+	{
+		return MakeShared<FDuplicateAssetsJob>(SourceAssets, NumDuplicates);
+	}
+
+	TSharedRef<FAssetJob> MakeFixUpRedirectorsJob()
+	{
+		return MakeShared<FFixUpRedirectorsJob>();
+	}
+
+	TSharedRef<FAssetJob> MakeValidateNamingConventionJob()
+	{
+		return MakeShared<FValidateNamingConventionJob>();
+	}
+
+	TSharedRef<FAssetJob> MakeCreateMaterialJob(UQuickMaterialWidget* MaterialWidget, const TArray<FAssetData>& TexturesData)
+	{
+		return MakeShared<FCreateMaterialJob>(MaterialWidget, TexturesData);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -5,6 +5,7 @@
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "AssetToolsModule.h"
+#include "Engine/Texture2D.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "MaterialEditorModule.h"
@@ -12,30 +13,21 @@
 #include "Materials/MaterialInstanceConstant.h" // Required for StaticClass()
 #include "MaterialGraph/MaterialGraph.h"
 #include "MaterialGraph/MaterialGraphNode.h"
+#include "ProcessData/AssetPreloader.h"
 
 #define LOCTEXT_NAMESPACE "QuickMaterialWidget"
 
 #pragma region QuickMaterialCreationCore
 void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 {
-	if (bOverrideMaterialName)
+	if (!HasValidMaterialName())
 	{
-		// Use the texture name if no input from user
-		if (MaterialName.IsEmpty() || MaterialName.Equals(TEXT("_M")))
-		{
-			DebugHeader::ShowNotification(
-				LOCTEXT("InvalidNameInput", "A custom material name is required!"),
-				ELogVerbosity::Warning
-			);
-
-			return;
-		}
+		return;
 	}
 
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	TArray<UTexture2D*> SelectedTextures;
 	FString SelectedTexturePath;
-	uint32 NumConnectedPins = 0;
 
 	if (!ProcessSelectedData(SelectedAssetsData, SelectedTextures, SelectedTexturePath))
 	{
@@ -44,17 +36,73 @@ void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 		return;
 	}
 
-	if (AssetNameExists(SelectedTexturePath, MaterialName))
+	if (!BeginMaterialCreation(SelectedTexturePath))
+	{
+		return;
+	}
+
+	// TODO: Convert this to a multimap, instead, and with each material input having its own array of suffixes
+	for (UTexture2D* SelectedTexture : SelectedTextures)
+	{
+		AddTextureToMaterial(SelectedTexture);
+	}
+
+	FinishMaterialCreation(false);
+}
+
+bool UQuickMaterialWidget::HasValidMaterialName()
+{
+	// Use the texture name if no input from user
+	if (bOverrideMaterialName && (MaterialName.IsEmpty() || MaterialName.Equals(TEXT("_M"))))
 	{
 		DebugHeader::ShowNotification(
-			FText::Format(LOCTEXT("DuplicateAssetName", "A material with name '{0}' exists. Skipping generation!"), FText::FromString(SelectedAssetsData[0].GetAsset()->GetName())),
+			LOCTEXT("InvalidNameInput", "A custom material name is required!"),
 			ELogVerbosity::Warning
 		);
-		MaterialName = TEXT("M_");
+
+		return false;
+	}
+
+	return true;
+}
+
+void UQuickMaterialWidget::SetMaterialNameFromTexture(const FString& InTextureName)
+{
+	if (bOverrideMaterialName)
+	{
 		return;
 	}
 
-	UMaterial* CreatedMaterial = CreateMaterialAsset(MaterialName, SelectedTexturePath);
+	MaterialName = InTextureName;
+	// Remove the texture prefix and add M_
+	MaterialName.RemoveFromStart(TEXT("T_"));
+	MaterialName.InsertAt(0, TEXT("M_"));
+	RemoveSuffixKeyword();
+}
+
+bool UQuickMaterialWidget::BeginMaterialCreation(const FString& InPackagePath)
+{
+	// The async version builds the material over several frames, its state lives in this widget until then
+	if (PendingMaterial)
+	{
+		DebugHeader::ShowNotification(
+			FText::Format(LOCTEXT("MaterialCreationPending", "Material '{0}' is still being created, try again once it is done."), FText::FromString(PendingMaterial->GetName())),
+			ELogVerbosity::Warning
+		);
+		return false;
+	}
+
+	if (AssetNameExists(InPackagePath, MaterialName))
+	{
+		DebugHeader::ShowNotification(
+			FText::Format(LOCTEXT("DuplicateAssetName", "A material with name '{0}' exists. Skipping generation!"), FText::FromString(MaterialName)),
+			ELogVerbosity::Warning
+		);
+		MaterialName = TEXT("M_");
+		return false;
+	}
+
+	UMaterial* CreatedMaterial = CreateMaterialAsset(MaterialName, InPackagePath);
 
 	if (!CreatedMaterial)
 	{
@@ -63,65 +111,83 @@ void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 			ELogVerbosity::Error
 		);
 
-		return;
+		return false;
 	}
 
+	PendingMaterial = CreatedMaterial;
+	PendingMaterialPath = InPackagePath;
+	NumConnectedPins = 0;
+
 	// Reset to starting value of the first node
 	NodeOffsetY = -600;
 
-	// TODO: Convert this to a multimap, instead, and with each material input having its own array of suffixes
-	for (UTexture2D* SelectedTexture : SelectedTextures)
+	return true;
+}
+
+void UQuickMaterialWidget::AddTextureToMaterial(UTexture2D* InTexture)
+{
+	if (!InTexture || !PendingMaterial)
 	{
-		if (!SelectedTexture)
-		{
-			continue;
-		}
+		return;
+	}
 
-		if (bAutoFixTextures)
-		{
-			FixTextureSettings(SelectedTexture, BaseColorSuffixes);
-			FixTextureSettings(SelectedTexture, MetallicSuffixes, TextureCompressionSettings::TC_Grayscale, false);
-			FixTextureSettings(SelectedTexture, OpacitySuffixes, TextureCompressionSettings::TC_Grayscale, false);
-			FixTextureSettings(SelectedTexture, SpecularSuffixes, TextureCompressionSettings::TC_Grayscale, false);
-			FixTextureSettings(SelectedTexture, RoughnessSuffixes, TextureCompressionSettings::TC_Grayscale, false);
-			FixTextureSettings(SelectedTexture, EmissiveColorSuffixes);
-			FixTextureSettings(SelectedTexture, NormalSuffixes, TextureCompressionSettings::TC_Normalmap, false);
-			FixTextureSettings(SelectedTexture, PackedSuffixes, TextureCompressionSettings::TC_Masks, false);
-		}
+	if (bAutoFixTextures)
+	{
+		FixTextureSettings(InTexture, BaseColorSuffixes);
+		FixTextureSettings(InTexture, MetallicSuffixes, TextureCompressionSettings::TC_Grayscale, false);
+		FixTextureSettings(InTexture, OpacitySuffixes, TextureCompressionSettings::TC_Grayscale, false);
+		FixTextureSettings(InTexture, SpecularSuffixes, TextureCompressionSettings::TC_Grayscale, false);
+		FixTextureSettings(InTexture, RoughnessSuffixes, TextureCompressionSettings::TC_Grayscale, false);
+		FixTextureSettings(InTexture, EmissiveColorSuffixes);
+		FixTextureSettings(InTexture, NormalSuffixes, TextureCompressionSettings::TC_Normalmap, false);
+		FixTextureSettings(InTexture, PackedSuffixes, TextureCompressionSettings::TC_Masks, false);
+	}
 
-		// Reset for every new material in ConnectNode()
-		bPackedPinsConnected = false;
+	// Reset for every new material in ConnectNode()
+	bPackedPinsConnected = false;
 
-		// Switch packing based on user enum selection
-		switch (ChannelPackType)
-		{
-		case EChannelPackType::ECPT_NoChannelPacking:
-			Default_CreateMaterialNodes(CreatedMaterial, SelectedTexture, NumConnectedPins);
-			break;
-		case EChannelPackType::ECPT_ORM:
-			ORM_CreateMaterialNodes(CreatedMaterial, SelectedTexture, NumConnectedPins);
-			break;
-		case EChannelPackType::ECPT_MRA:
-			DebugHeader::ShowNotification(LOCTEXT("TODO", "TODO: Implement MRA packing."));
-			break;
-		case EChannelPackType::ECPT_MAX:
-			break;
-		default:
-			break;
-		}
+	// Switch packing based on user enum selection
+	switch (ChannelPackType)
+	{
+	case EChannelPackType::ECPT_NoChannelPacking:
+		Default_CreateMaterialNodes(PendingMaterial, InTexture, NumConnectedPins);
+		break;
+	case EChannelPackType::ECPT_ORM:
+		ORM_CreateMaterialNodes(PendingMaterial, InTexture, NumConnectedPins);
+		break;
+	case EChannelPackType::ECPT_MRA:
+		DebugHeader::ShowNotification(LOCTEXT("TODO", "TODO: Implement MRA packing."));
+		break;
+	case EChannelPackType::ECPT_MAX:
+		break;
+	default:
+		break;
 	}
+}
 
-	// Compile material outside of a loop, once all changes have been made
+void UQuickMaterialWidget::FinishMaterialCreation(bool bCancelled)
+{
+	UMaterial* CreatedMaterial = PendingMaterial;
+	const FString CreatedMaterialPath = PendingMaterialPath;
+	PendingMaterial = nullptr;
+	PendingMaterialPath.Reset();
+
+	if (!CreatedMaterial)
+	{
+		return;
+	}
+
+	// Compile material outside of a loop, once all changes have been made. A cancelled material keeps the nodes made so far
 	CreatedMaterial->PostEditChange();
 
-	if (bCreateMaterialInstance)
+	if (bCreateMaterialInstance && !bCancelled)
 	{
-		UMaterialInstanceConstant* CreatedMaterialInstance = CreateMaterialInstanceAsset(MaterialName, SelectedTexturePath, CreatedMaterial);
+		UMaterialInstanceConstant* CreatedMaterialInstance = CreateMaterialInstanceAsset(MaterialName, CreatedMaterialPath, CreatedMaterial);
 
 		if (!CreatedMaterialInstance)
 		{
 			DebugHeader::ShowNotification(
-				FText::Format(LOCTEXT("MaterialInstanceNotCreated", "Error creating material instance '{0}'."), FText::FromString(CreatedMaterialInstance->GetName())),
+				FText::Format(LOCTEXT("MaterialInstanceNotCreated", "Error creating material instance '{0}'."), FText::FromString(MaterialName)),
 				ELogVerbosity::Error
 			);
 			return;
@@ -140,7 +206,10 @@ void UQuickMaterialWidget::CreateMaterialFromSelectedTextures()
 		UEditorAssetLibrary::SaveAsset(CreatedMaterial->GetPathName());
 	}
 
-	DebugHeader::ShowNotification(FText::Format(LOCTEXT("MaterialCreated", "New material '{0}' has been created succesfully!"), FText::FromString(CreatedMaterial->GetName())));
+	if (!bCancelled)
+	{
+		DebugHeader::ShowNotification(FText::Format(LOCTEXT("MaterialCreated", "New material '{0}' has been created succesfully!"), FText::FromString(CreatedMaterial->GetName())));
+	}
 
 	// Reset the name
 	MaterialName = TEXT("M_");
@@ -161,38 +230,50 @@ bool UQuickMaterialWidget::ProcessSelectedData(const TArray<FAssetData>& InSelec
 		return false;
 	}
 
-	bool bMaterialRenamed = false;
-
+	// The class is known from the asset data, so a wrong selection is rejected before anything is loaded
 	for (const FAssetData& AssetData : InSelectedAssetsData)
 	{
-		UObject* SelectedAsset = AssetData.GetAsset();
-
-		if (!SelectedAsset)
+		if (!AssetData.IsInstanceOf(UTexture2D::StaticClass()))
 		{
-			continue;
+			return false;
 		}
+	}
 
-		UTexture2D* SelectedTexture = Cast<UTexture2D>(SelectedAsset);
+	// Every texture is requested at once, slots keep the selection order whatever order the loads finish in
+	TArray<UTexture2D*> LoadedTextures;
+	LoadedTextures.SetNumZeroed(InSelectedAssetsData.Num());
+
+	const bool bLoaded = FAssetPreloader::LoadAndProcess(InSelectedAssetsData, [&LoadedTextures](int32 AssetIndex, UObject* Asset)
+	{
+		LoadedTextures[AssetIndex] = Cast<UTexture2D>(Asset);
+	}, FText::Format(LOCTEXT("LoadingTextures", "Loading {0} texture(s)..."), InSelectedAssetsData.Num()));
+
+	if (!bLoaded)
+	{
+		return false;
+	}
+
+	bool bMaterialRenamed = false;
+
+	for (int32 Index = 0; Index < InSelectedAssetsData.Num(); ++Index)
+	{
+		UTexture2D* SelectedTexture = LoadedTextures[Index];
 
 		if (!SelectedTexture)
 		{
-			return false;
+			continue;
 		}
 
 		OutSelectedTextures.Add(SelectedTexture);
 
 		if (OutSelectedPackagePath.IsEmpty())
 		{
-			OutSelectedPackagePath = AssetData.PackagePath.ToString();
+			OutSelectedPackagePath = InSelectedAssetsData[Index].PackagePath.ToString();
 		}
 
-		if (!bOverrideMaterialName && !bMaterialRenamed)
+		if (!bMaterialRenamed)
 		{
-			MaterialName = SelectedTexture->GetName();
-			// Remove the texture prefix and add M_
-			MaterialName.RemoveFromStart(TEXT("T_"));
-			MaterialName.InsertAt(0, TEXT("M_"));
-			RemoveSuffixKeyword();
+			SetMaterialNameFromTexture(SelectedTexture->GetName());
 			bMaterialRenamed = true;
 		}
 	}
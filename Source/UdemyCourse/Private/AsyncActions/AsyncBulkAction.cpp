@@ -0,0 +1,115 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "AsyncActions/AsyncBulkAction.h"
+#include "UdemyCourse.h"
+#include "ActorActions/QuickActorJobs.h"
+#include "AssetActions/QuickAssetJobs.h"
+
+UAsyncBulkAction* UAsyncBulkAction::DuplicateAssetsAsync(const TArray<FAssetData>& Assets, int32 NumDuplicates)
+{
+	return Create(QuickAssetJobs::MakeDuplicateAssetsJob(Assets, FMath::Max(NumDuplicates, 0)));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::FixUpAllRedirectorsAsync()
+{
+	return Create(QuickAssetJobs::MakeFixUpRedirectorsJob());
+}
+
+UAsyncBulkAction* UAsyncBulkAction::ValidateNamingConventionAsync()
+{
+	return Create(QuickAssetJobs::MakeValidateNamingConventionJob());
+}
+
+UAsyncBulkAction* UAsyncBulkAction::DuplicateActorsAsync(const TArray<AActor*>& Actors, int32 NumDuplicates, FVector OffsetDistance, FRotator RandomRotation)
+{
+	return Create(QuickActorJobs::MakeDuplicateActorsJob(Actors, FMath::Max(NumDuplicates, 0), OffsetDistance, RandomRotation));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::RandomizeActorsRotationAsync(const TArray<AActor*>& Actors, FRotator RandomRotation)
+{
+	FActorRandomTransform RandomTransform;
+	RandomTransform.MaxRotation = RandomRotation;
+	return Create(QuickActorJobs::MakeRandomizeActorsTransformJob(Actors, RandomTransform));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::RandomizeActorsOffsetAsync(const TArray<AActor*>& Actors, FVector OffsetDistance)
+{
+	FActorRandomTransform RandomTransform;
+	RandomTransform.MaxOffset = OffsetDistance;
+	return Create(QuickActorJobs::MakeRandomizeActorsTransformJob(Actors, RandomTransform));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::RandomizeActorsScaleAsync(const TArray<AActor*>& Actors, FVector ScaleMin, FVector ScaleMax)
+{
+	FActorRandomTransform RandomTransform;
+	RandomTransform.bRandomizeScale = true;
+	RandomTransform.ScaleMin = ScaleMin;
+	RandomTransform.ScaleMax = ScaleMax;
+	return Create(QuickActorJobs::MakeRandomizeActorsTransformJob(Actors, RandomTransform));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::RandomizeActorsTransformAsync(const TArray<AActor*>& Actors, FVector OffsetDistance, FRotator RandomRotation, FVector ScaleMin, FVector ScaleMax)
+{
+	// Same as UQuickActorActionsWidget::RandomizeSelectedActorsTransform(), which always sets the scale
+	FActorRandomTransform RandomTransform;
+	RandomTransform.MaxRotation = RandomRotation;
+	RandomTransform.MaxOffset = OffsetDistance;
+	RandomTransform.bRandomizeScale = true;
+	RandomTransform.ScaleMin = ScaleMin;
+	RandomTransform.ScaleMax = ScaleMax;
+	return Create(QuickActorJobs::MakeRandomizeActorsTransformJob(Actors, RandomTransform));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::CreateMaterialFromTexturesAsync(UQuickMaterialWidget* MaterialWidget, const TArray<FAssetData>& Textures)
+{
+	return Create(QuickAssetJobs::MakeCreateMaterialJob(MaterialWidget, Textures));
+}
+
+UAsyncBulkAction* UAsyncBulkAction::Create(const TSharedRef<FAssetJob>& InJob)
+{
+	UAsyncBulkAction* Action = NewObject<UAsyncBulkAction>();
+	Action->Job = InJob;
+	return Action;
+}
+
+void UAsyncBulkAction::Activate()
+{
+	if (!Job.IsValid() || bIsRunning)
+	{
+		return;
+	}
+
+	// Editor actions have no game instance to register with, rooted until the job reports back
+	AddToRoot();
+	bIsRunning = true;
+
+	// Bound before queueing, a job that coalesces reports through the one it was merged into
+	Job->OnProgress().AddWeakLambda(this, [this](int32 NumStepsDone, int32 NumSteps) {OnJobProgress(NumStepsDone, NumSteps);});
+	Job->OnFinished().AddWeakLambda(this, [this](bool bCancelled) {OnJobFinished(bCancelled);});
+
+	FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetJobScheduler().Enqueue(Job.ToSharedRef());
+}
+
+void UAsyncBulkAction::Cancel()
+{
+	if (bIsRunning && Job.IsValid())
+	{
+		FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse")).GetJobScheduler().Cancel(Job.ToSharedRef());
+	}
+}
+
+void UAsyncBulkAction::OnJobProgress(int32 NumStepsDone, int32 NumSteps)
+{
+	OnProgress.Broadcast(NumSteps > 0 ? static_cast<float>(NumStepsDone) / NumSteps : 1.f, NumStepsDone, NumSteps);
+}
+
+void UAsyncBulkAction::OnJobFinished(bool bCancelled)
+{
+	bIsRunning = false;
+	Job.Reset();
+
+	OnCompleted.Broadcast(bCancelled);
+
+	SetReadyToDestroy();
+	RemoveFromRoot();
+}
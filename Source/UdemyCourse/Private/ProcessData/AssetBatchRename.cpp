@@ -0,0 +1,232 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetBatchRename.h"
+#include "ProcessData/AssetPreloader.h"
+#include "ProcessData/AssetWindowedExecutor.h"
+#include "DebugHeader.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "FileHelpers.h" // UEditorLoadingAndSavingUtils
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/ObjectRedirector.h"
+
+#define LOCTEXT_NAMESPACE "AssetBatchRename"
+
+int32 FAssetBatchRename::ResolveNameConflicts(TArray<FAssetBatchRenameItem>& Items, TArray<FString>& OutRequestedNames)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Asset names per destination folder, filled from the registry the first time a folder comes up.
+	// Assets of the batch keep their old names in it, the batch is renamed one by one so they aren't free yet
+	TMap<FName, TSet<FName>> NamesByPackagePath;
+	auto GetFolderNames = [&AssetRegistry, &NamesByPackagePath](FName PackagePath) -> TSet<FName>&
+	{
+		if (TSet<FName>* FolderNames = NamesByPackagePath.Find(PackagePath))
+		{
+			return *FolderNames;
+		}
+
+		TArray<FAssetData> FolderAssets;
+		AssetRegistry.GetAssetsByPath(PackagePath, FolderAssets);
+
+		TSet<FName>& FolderNames = NamesByPackagePath.Add(PackagePath);
+		FolderNames.Reserve(FolderAssets.Num());
+
+		for (const FAssetData& FolderAsset : FolderAssets)
+		{
+			FolderNames.Add(FolderAsset.AssetName);
+		}
+
+		return FolderNames;
+	};
+
+	// A name that was never made into an FName can't be taken, so most candidates don't touch the name table
+	auto IsTaken = [](const TSet<FName>& FolderNames, const FString& Name)
+	{
+		const FName ExistingName(*Name, FNAME_Find);
+		return !ExistingName.IsNone() && FolderNames.Contains(ExistingName);
+	};
+
+	TArray<FAssetBatchRenameItem> ResolvedItems;
+	ResolvedItems.Reserve(Items.Num());
+	OutRequestedNames.Reset(Items.Num());
+	int32 NumResolved = 0;
+
+	for (FAssetBatchRenameItem& Item : Items)
+	{
+		const FName PackagePath(*Item.NewPackagePath);
+
+		// FName comparison, so a change in case alone is dropped as well, the engine can't rename that
+		if (PackagePath == Item.AssetData.PackagePath && FName(*Item.NewName) == Item.AssetData.AssetName)
+		{
+			continue;
+		}
+
+		TSet<FName>& FolderNames = GetFolderNames(PackagePath);
+		OutRequestedNames.Add(Item.NewName);
+
+		if (IsTaken(FolderNames, Item.NewName))
+		{
+			// Continue from a trailing number if there is one, SM_Crate_3 tries SM_Crate_4 next
+			int32 DigitsStart = Item.NewName.Len();
+
+			while (DigitsStart > 0 && FChar::IsDigit(Item.NewName[DigitsStart - 1]))
+			{
+				--DigitsStart;
+			}
+
+			const bool bHasNumber = DigitsStart < Item.NewName.Len() && Item.NewName.Len() - DigitsStart < 9;
+			const FString BaseName = bHasNumber ? Item.NewName.Left(DigitsStart) : Item.NewName + TEXT("_");
+			int32 Number = bHasNumber ? FCString::Atoi(*Item.NewName + DigitsStart) + 1 : 1;
+			FString Candidate = BaseName + FString::FromInt(Number);
+
+			while (IsTaken(FolderNames, Candidate))
+			{
+				Candidate = BaseName + FString::FromInt(++Number);
+			}
+
+			Item.NewName = MoveTemp(Candidate);
+			++NumResolved;
+		}
+
+		FolderNames.Add(FName(*Item.NewName));
+		ResolvedItems.Add(MoveTemp(Item));
+	}
+
+	Items = MoveTemp(ResolvedItems);
+	UE_LOG(LogUdemyCourse, Log, TEXT("Rename preview: %d asset(s) to rename, %d name conflict(s) resolved"), Items.Num(), NumResolved);
+	return Items.Num();
+}
+
+TArray<FAssetData> FAssetBatchRename::RenameAssets(const TArray<FAssetBatchRenameItem>& Items, const FText& ProgressMessage)
+{
+	TArray<FAssetData> RenamedAssets;
+
+	// One batch per window, so huge selections don't keep every renamed package loaded until the end.
+	// Renamed packages are dirty and can't be unloaded, so they are saved per window once there is more than one
+	const bool bSaveWindows = FAssetWindowedExecutor::GetWindowSize(Items.Num()) < Items.Num();
+
+	FAssetWindowedExecutor::ForEachWindow(Items.Num(), [&Items, &RenamedAssets, bSaveWindows](int32 WindowStart, int32 WindowCount, TArray<UPackage*>& OutPackagesToRelease)
+	{
+		return RenameWindow(TArrayView<const FAssetBatchRenameItem>(Items).Slice(WindowStart, WindowCount), bSaveWindows, RenamedAssets, OutPackagesToRelease);
+	}, ProgressMessage);
+
+	return RenamedAssets;
+}
+
+bool FAssetBatchRename::RenameWindow(TArrayView<const FAssetBatchRenameItem> Items, bool bSaveRenamedPackages, TArray<FAssetData>& OutRenamedAssets, TArray<UPackage*>& OutPackagesToRelease)
+{
+	FScopedSlowTask SlowTask(4.f, LOCTEXT("RenamingWindow", "Renaming assets..."));
+
+	// Renaming works on loaded objects, the whole window is loaded asynchronously up front
+	SlowTask.EnterProgressFrame(1.f, LOCTEXT("LoadingAssets", "Loading assets..."));
+	TArray<FAssetData> AssetsToLoad;
+	TBitArray<> WasLoaded;
+	AssetsToLoad.Reserve(Items.Num());
+
+	for (const FAssetBatchRenameItem& Item : Items)
+	{
+		AssetsToLoad.Add(Item.AssetData);
+		WasLoaded.Add(Item.AssetData.IsAssetLoaded());
+	}
+
+	TArray<UObject*> LoadedAssets;
+	LoadedAssets.SetNumZeroed(Items.Num());
+
+	const bool bLoaded = FAssetPreloader::LoadAndProcess(AssetsToLoad, [&LoadedAssets](int32 AssetIndex, UObject* Asset)
+	{
+		LoadedAssets[AssetIndex] = Asset;
+	}, FText::Format(LOCTEXT("LoadingAssetsCount", "Loading {0} asset(s)..."), AssetsToLoad.Num()));
+
+	// Nothing of this window is renamed yet, so a cancel leaves it and the windows after it untouched
+	if (!bLoaded)
+	{
+		return false;
+	}
+
+	// Kept in the order of the items, callers rely on it
+	TArray<FAssetRenameData> AssetsToRename;
+	TArray<const FAssetBatchRenameItem*> RenamedItems;
+	TArray<FSoftObjectPath> RenamedTo;
+
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		const FAssetBatchRenameItem& Item = Items[Index];
+
+		if (!LoadedAssets[Index])
+		{
+			UE_LOG(LogUdemyCourse, Warning, TEXT("Asset could not be loaded for renaming: %s"), *Item.AssetData.GetObjectPathString());
+			continue;
+		}
+
+		AssetsToRename.Emplace(LoadedAssets[Index], Item.NewPackagePath, Item.NewName);
+		RenamedItems.Add(&Item);
+		RenamedTo.Add(FSoftObjectPath(FString::Printf(TEXT("%s/%s.%s"), *Item.NewPackagePath, *Item.NewName, *Item.NewName)));
+	}
+
+	// A single rename for the whole window, so referencing packages are only loaded and resaved once
+	SlowTask.EnterProgressFrame(1.f, LOCTEXT("RenamingAssets", "Renaming assets..."));
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+	AssetTools.RenameAssets(AssetsToRename);
+
+	// RenameAssets() reports success for the batch only, the registry tells which assets arrived
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TArray<UObjectRedirector*> RedirectorsToFix;
+	TArray<UPackage*> PackagesToSave;
+
+	for (int32 Index = 0; Index < RenamedItems.Num(); ++Index)
+	{
+		const FAssetData& RenamedFrom = RenamedItems[Index]->AssetData;
+
+		if (!AssetRegistry.GetAssetByObjectPath(RenamedTo[Index]).IsValid())
+		{
+			UE_LOG(LogUdemyCourse, Warning, TEXT("Asset could not be renamed to %s"), *RenamedTo[Index].ToString());
+			continue;
+		}
+
+		OutRenamedAssets.Add(RenamedFrom);
+
+		// Only what this window loaded is saved, assets the user already had open are left for them to save
+		const int32 ItemIndex = static_cast<int32>(RenamedItems[Index] - Items.GetData());
+
+		if (bSaveRenamedPackages && !WasLoaded[ItemIndex] && IsValid(LoadedAssets[ItemIndex]))
+		{
+			PackagesToSave.Add(LoadedAssets[ItemIndex]->GetPackage());
+		}
+
+		if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *RenamedFrom.GetObjectPathString()))
+		{
+			RedirectorsToFix.Add(Redirector);
+		}
+	}
+
+	// One fixup pass over every redirector the window left behind, they are deleted afterwards
+	SlowTask.EnterProgressFrame(1.f, LOCTEXT("FixingRedirectors", "Fixing up redirectors..."));
+
+	if (!RedirectorsToFix.IsEmpty())
+	{
+		AssetTools.FixupReferencers(RedirectorsToFix);
+	}
+
+	// A single bulk save for the window, as the duplicate job does, so the packages can be released below
+	SlowTask.EnterProgressFrame(1.f, LOCTEXT("SavingRenamedAssets", "Saving renamed assets..."));
+
+	if (!PackagesToSave.IsEmpty() && !UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false))
+	{
+		UE_LOG(LogUdemyCourse, Error, TEXT("Not every renamed asset could be saved, unsaved ones stay loaded"));
+	}
+
+	// Only what this window loaded is released, assets the user already had open stay loaded.
+	// The objects live in their new packages now
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		if (!WasLoaded[Index] && IsValid(LoadedAssets[Index]))
+		{
+			OutPackagesToRelease.Add(LoadedAssets[Index]->GetPackage());
+		}
+	}
+
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,24 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetClassHierarchyCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+const TArray<FTopLevelAssetPath>& FAssetClassHierarchyCache::GetClassHierarchy(const FTopLevelAssetPath& ClassPath)
+{
+	if (const TArray<FTopLevelAssetPath>* CachedHierarchy = ClassHierarchies.Find(ClassPath))
+	{
+		return *CachedHierarchy;
+	}
+
+	// The registry walks its cached inheritance map, native and Blueprint classes alike, without loading anything
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TArray<FTopLevelAssetPath> AncestorPaths;
+	AssetRegistry.GetAncestorClassNames(ClassPath, AncestorPaths);
+
+	TArray<FTopLevelAssetPath> Hierarchy;
+	Hierarchy.Reserve(AncestorPaths.Num() + 1);
+	Hierarchy.Add(ClassPath);
+	Hierarchy.Append(AncestorPaths);
+
+	return ClassHierarchies.Add(ClassPath, MoveTemp(Hierarchy));
+}
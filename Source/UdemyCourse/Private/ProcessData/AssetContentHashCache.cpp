@@ -0,0 +1,275 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetContentHashCache.h"
+#include "DebugHeader.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/ArchiveProxy.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/PackageFileSummary.h"
+
+#define LOCTEXT_NAMESPACE "AssetContentHashCache"
+
+TArray<FAssetContentHash> FAssetContentHashCache::GetHashes(const TArray<FName>& PackageNames, bool* bOutCancelled)
+{
+	TArray<FAssetContentHash> Hashes;
+	Hashes.SetNum(PackageNames.Num());
+
+	if (bOutCancelled)
+	{
+		*bOutCancelled = false;
+	}
+
+	// Stat the files up front, an unchanged timestamp and size means the cached hash still holds
+	struct FHashJob
+	{
+		int32 Index;
+		FString Filename;
+		FFileStatData StatData;
+		FAssetContentHash Hash;
+	};
+
+	TArray<FHashJob> Jobs;
+	IFileManager& FileManager = IFileManager::Get();
+
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		FString Filename;
+
+		if (!FPackageName::DoesPackageExist(PackageNames[Index].ToString(), &Filename))
+		{
+			continue;
+		}
+
+		const FFileStatData StatData = FileManager.GetStatData(*Filename);
+		const FCacheEntry* CachedEntry = Entries.Find(PackageNames[Index]);
+
+		if (CachedEntry && CachedEntry->Timestamp == StatData.ModificationTime && CachedEntry->FileSize == StatData.FileSize)
+		{
+			Hashes[Index] = CachedEntry->Hash;
+			continue;
+		}
+
+		Jobs.Add({Index, MoveTemp(Filename), StatData, FAssetContentHash()});
+	}
+
+	if (Jobs.IsEmpty())
+	{
+		return Hashes;
+	}
+
+	FScopedSlowTask SlowTask(Jobs.Num(), FText::Format(LOCTEXT("HashingPackages", "Hashing {0} package(s)..."), Jobs.Num()));
+	SlowTask.MakeDialogDelayed(0.5f, true);
+
+	int32 NumHashed = 0;
+
+	// Batched, so the dialog stays responsive and a cancel doesn't wait for the whole set
+	while (NumHashed < Jobs.Num() && !SlowTask.ShouldCancel())
+	{
+		const int32 BatchCount = FMath::Min(HashBatchSize, Jobs.Num() - NumHashed);
+		SlowTask.EnterProgressFrame(BatchCount);
+
+		// Each worker only touches its own job, reading files is the dominant cost
+		ParallelFor(BatchCount, [&Jobs, &PackageNames, NumHashed](int32 BatchIndex)
+		{
+			FHashJob& Job = Jobs[NumHashed + BatchIndex];
+			Job.Hash = HashPackagePayload(Job.Filename, PackageNames[Job.Index]);
+		});
+
+		for (int32 JobIndex = NumHashed; JobIndex < NumHashed + BatchCount; ++JobIndex)
+		{
+			const FHashJob& Job = Jobs[JobIndex];
+			Hashes[Job.Index] = Job.Hash;
+
+			if (Job.Hash.IsValid())
+			{
+				Entries.Add(PackageNames[Job.Index], {Job.StatData.ModificationTime, Job.StatData.FileSize, Job.Hash});
+			}
+		}
+
+		NumHashed += BatchCount;
+	}
+
+	if (bOutCancelled)
+	{
+		*bOutCancelled = NumHashed < Jobs.Num();
+	}
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Hashed %d of %d package(s), %d served from cache"), NumHashed, Jobs.Num(), PackageNames.Num() - Jobs.Num());
+	return Hashes;
+}
+
+namespace
+{
+	/** Reads FNames the way the linker stores them, as indices into the package name map */
+	class FNameMapReader : public FArchiveProxy
+	{
+	public:
+		FNameMapReader(FArchive& InInnerArchive, const TArray<FName>& InNameMap)
+			: FArchiveProxy(InInnerArchive)
+			, NameMap(InNameMap)
+		{
+		}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 NameIndex = 0;
+			int32 Number = 0;
+			InnerArchive << NameIndex << Number;
+
+			if (!NameMap.IsValidIndex(NameIndex))
+			{
+				SetError();
+				Name = NAME_None;
+				return *this;
+			}
+
+			Name = FName(NameMap[NameIndex], Number);
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& NameMap;
+	};
+
+	void HashString(FMD5& MD5, const FString& String)
+	{
+		const FTCHARToUTF8 Utf8(*String);
+		MD5.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length() + 1);
+	}
+}
+
+FAssetContentHash FAssetContentHashCache::HashPackagePayload(const FString& Filename, FName PackageName)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+
+	if (!Reader)
+	{
+		return FAssetContentHash();
+	}
+
+	FPackageFileSummary Summary;
+	*Reader << Summary;
+
+	if (Reader->IsError() || Summary.TotalHeaderSize <= 0 || Summary.TotalHeaderSize > Reader->TotalSize())
+	{
+		return FAssetContentHash();
+	}
+
+	// The name and import maps are only readable with the versions the package was saved with
+	Reader->SetUEVer(Summary.GetFileVersionUE());
+	Reader->SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+	Reader->SetEngineVer(Summary.SavedByEngineVersion);
+	Reader->SetCustomVersions(Summary.GetCustomVersionContainer());
+	Reader->SetFilterEditorOnly((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0);
+
+	TArray<FName> NameMap;
+	NameMap.Reserve(Summary.NameCount);
+	Reader->Seek(Summary.NameOffset);
+
+	for (int32 NameIndex = 0; NameIndex < Summary.NameCount && !Reader->IsError(); ++NameIndex)
+	{
+		FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
+		*Reader << NameEntry;
+		NameMap.Add(FName(NameEntry));
+	}
+
+	TArray<FObjectImport> ImportMap;
+	ImportMap.SetNum(Summary.ImportCount);
+	Reader->Seek(Summary.ImportOffset);
+
+	FNameMapReader NameMapReader(*Reader, NameMap);
+
+	for (FObjectImport& Import : ImportMap)
+	{
+		NameMapReader << Import;
+	}
+
+	if (Reader->IsError() || NameMapReader.IsError())
+	{
+		return FAssetContentHash();
+	}
+
+	FMD5 MD5;
+
+	// The payload stores names as indices, hashing what they resolve to keeps two assets that only differ
+	// in names from colliding. The package's own names are left out, they differ between every copy
+	const FString ShortPackageName = FPackageName::GetShortName(PackageName);
+
+	for (const FName Name : NameMap)
+	{
+		if (Name != PackageName && Name.ToString() != ShortPackageName)
+		{
+			HashString(MD5, Name.ToString());
+		}
+	}
+
+	// Object references in the payload are indices into the import map, so the referenced paths go in as well
+	for (const FObjectImport& Import : ImportMap)
+	{
+		FString ImportPath = Import.ObjectName.ToString();
+		FPackageIndex OuterIndex = Import.OuterIndex;
+
+		// Bounded by the import count, a malformed outer chain can't loop forever
+		for (int32 Depth = 0; OuterIndex.IsImport() && Depth < ImportMap.Num(); ++Depth)
+		{
+			if (!ImportMap.IsValidIndex(OuterIndex.ToImport()))
+			{
+				break;
+			}
+
+			const FObjectImport& Outer = ImportMap[OuterIndex.ToImport()];
+			ImportPath = Outer.ObjectName.ToString() / ImportPath;
+			OuterIndex = Outer.OuterIndex;
+		}
+
+		HashString(MD5, Import.ClassPackage.ToString() + TEXT(".") + Import.ClassName.ToString() + TEXT(" ") + ImportPath);
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(64 * 1024);
+
+	auto HashRemaining = [&MD5, &Buffer](FArchive& Archive)
+	{
+		int64 Remaining = Archive.TotalSize() - Archive.Tell();
+
+		while (Remaining > 0 && !Archive.IsError())
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Remaining, Buffer.Num());
+			Archive.Serialize(Buffer.GetData(), ChunkSize);
+			MD5.Update(Buffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+	};
+
+	Reader->Seek(Summary.TotalHeaderSize);
+	HashRemaining(*Reader);
+
+	// Split exports are the bulk of the payload, when present
+	const FString ExportsFilename = FPaths::ChangeExtension(Filename, TEXT(".uexp"));
+	TUniquePtr<FArchive> ExportsReader(IFileManager::Get().CreateFileReader(*ExportsFilename, FILEREAD_Silent));
+
+	if (ExportsReader)
+	{
+		HashRemaining(*ExportsReader);
+	}
+
+	if (Reader->IsError() || (ExportsReader && ExportsReader->IsError()))
+	{
+		return FAssetContentHash();
+	}
+
+	uint8 Digest[16];
+	MD5.Final(Digest);
+
+	FAssetContentHash Hash;
+	FMemory::Memcpy(&Hash.High, Digest, sizeof(uint64));
+	FMemory::Memcpy(&Hash.Low, Digest + sizeof(uint64), sizeof(uint64));
+	return Hash;
+}
+
+#undef LOCTEXT_NAMESPACE
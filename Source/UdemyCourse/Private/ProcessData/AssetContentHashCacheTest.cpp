@@ -0,0 +1,83 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetContentHashCache.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Saves two material instances that only differ in the texture they reference and checks that their content hashes differ.
+ * Their payloads are byte for byte the same, the texture only shows up in the import map.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetContentHashReferenceTest, "UdemyCourse.ContentHash.DifferentReferences", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAssetContentHashReferenceTest::RunTest(const FString& Parameters)
+{
+	const FString TestRoot = TEXT("/Temp/UdemyCourseTests/ContentHash");
+	TArray<UObject*> CreatedAssets;
+	TArray<FString> SavedFilenames;
+
+	auto CreateTexture = [&TestRoot, &CreatedAssets](const TCHAR* AssetName)
+	{
+		UPackage* Package = CreatePackage(*(TestRoot / AssetName));
+		UTexture2D* Texture = NewObject<UTexture2D>(Package, AssetName, RF_Public | RF_Standalone);
+		CreatedAssets.Add(Texture);
+		return Texture;
+	};
+
+	auto SaveMaterialInstance = [this, &TestRoot, &CreatedAssets, &SavedFilenames](const TCHAR* AssetName, UTexture2D* Texture)
+	{
+		const FString PackageName = TestRoot / AssetName;
+		UPackage* Package = CreatePackage(*PackageName);
+		UMaterialInstanceConstant* MaterialInstance = NewObject<UMaterialInstanceConstant>(Package, AssetName, RF_Public | RF_Standalone);
+		MaterialInstance->SetParentEditorOnly(UMaterial::GetDefaultMaterial(MD_Surface));
+		MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Texture")), Texture);
+		CreatedAssets.Add(MaterialInstance);
+
+		const FString Filename = FPaths::AutomationTransientDir() / TEXT("ContentHash") / FString(AssetName) + FPackageName::GetAssetPackageExtension();
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		if (!UPackage::SavePackage(Package, MaterialInstance, *Filename, SaveArgs))
+		{
+			AddError(FString::Printf(TEXT("Couldn't save %s"), *PackageName));
+			return FAssetContentHash();
+		}
+
+		SavedFilenames.Add(Filename);
+		return FAssetContentHashCache::HashPackagePayload(Filename, FName(*PackageName));
+	};
+
+	const FAssetContentHash HashA = SaveMaterialInstance(TEXT("MI_HashTestA"), CreateTexture(TEXT("T_HashTestA")));
+	const FAssetContentHash HashB = SaveMaterialInstance(TEXT("MI_HashTestB"), CreateTexture(TEXT("T_HashTestB")));
+
+	TestTrue(TEXT("First material instance was hashed"), HashA.IsValid());
+	TestTrue(TEXT("Second material instance was hashed"), HashB.IsValid());
+	TestFalse(TEXT("Material instances referencing different textures hash differently"), HashA == HashB);
+
+	for (const FString& Filename : SavedFilenames)
+	{
+		IFileManager::Get().Delete(*Filename, false, true, true);
+	}
+
+	// Let the next garbage collection take the test assets
+	for (UObject* Asset : CreatedAssets)
+	{
+		Asset->ClearFlags(RF_Public | RF_Standalone);
+		Asset->MarkAsGarbage();
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,723 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetDeletionPipeline.h"
+#include "DebugHeader.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "HAL/FileManager.h"
+#include "ISourceControlModule.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "SourceControlHelpers.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/ReferencerFinder.h"
+
+#define LOCTEXT_NAMESPACE "AssetDeletionPipeline"
+
+FAssetDeletionPipeline::FAssetDeletionPipeline(const TArray<FAssetData>& InAssetsToDelete, FOnAssetDeletionFinished InOnFinished)
+	: NumRequested(InAssetsToDelete.Num())
+	, OnFinished(InOnFinished)
+{
+	StageInput.Reserve(InAssetsToDelete.Num());
+
+	for (const FAssetData& AssetToDelete : InAssetsToDelete)
+	{
+		StageInput.Add({AssetToDelete});
+		PendingPackages.Add(AssetToDelete.PackageName);
+		++NumRequestedByPackage.FindOrAdd(AssetToDelete.PackageName);
+	}
+}
+
+FAssetDeletionPipeline::~FAssetDeletionPipeline()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	// Destroyed while still running, e.g. on module shutdown
+	if (IsRunning())
+	{
+		DebugHeader::FinishPendingNotification(ProgressNotification, LOCTEXT("DeletionAborted", "Asset deletion was aborted."), false);
+	}
+}
+
+void FAssetDeletionPipeline::Start()
+{
+	ProgressNotification = DebugHeader::ShowPendingNotification(
+		FText::Format(LOCTEXT("DeletionStarted", "Deleting {0} asset(s)..."), NumRequested),
+		FSimpleDelegate::CreateSP(this, &FAssetDeletionPipeline::Cancel)
+	);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FAssetDeletionPipeline::Tick));
+}
+
+void FAssetDeletionPipeline::Cancel()
+{
+	// Past the unload stage the assets are out of memory already, stopping would only leave their files behind
+	if (!IsRunning() || Stage > EStage::Unload)
+	{
+		return;
+	}
+
+	bCancelRequested = true;
+
+	if (ProgressNotification.IsValid())
+	{
+		ProgressNotification->SetText(LOCTEXT("DeletionCancelling", "Cancelling asset deletion..."));
+	}
+}
+
+bool FAssetDeletionPipeline::Tick(float DeltaTime)
+{
+	FrameDeadline = FPlatformTime::Seconds() + FrameBudgetSeconds;
+
+	while (IsRunning() && FPlatformTime::Seconds() < FrameDeadline)
+	{
+		if (bCancelRequested)
+		{
+			bCancelRequested = false;
+			CancelRemainingAssets();
+			continue;
+		}
+
+		if (ProcessBatch())
+		{
+			EnterStage(static_cast<EStage>(static_cast<uint8>(Stage) + 1));
+		}
+	}
+
+	if (!IsRunning())
+	{
+		// Returning false removes the ticker
+		TickerHandle.Reset();
+		Finish();
+		return false;
+	}
+
+	UpdateNotification();
+	return true;
+}
+
+bool FAssetDeletionPipeline::ProcessBatch()
+{
+	switch (Stage)
+	{
+	case EStage::Validate:
+		return ValidateBatch();
+	case EStage::Load:
+		return LoadBatch();
+	case EStage::Unload:
+		return UnloadBatch();
+	case EStage::DeleteFiles:
+		return DeleteFilesBatch();
+	case EStage::UpdateRegistry:
+		return UpdateRegistryBatch();
+	default:
+		return true;
+	}
+}
+
+#pragma region Stages
+
+bool FAssetDeletionPipeline::ValidateBatch()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const int32 BatchEnd = FMath::Min(StageCursor + BatchSize, StageInput.Num());
+
+	for (; StageCursor < BatchEnd; ++StageCursor)
+	{
+		FPendingAsset& PendingAsset = StageInput[StageCursor];
+
+		if (!PendingAsset.AssetData.IsValid() || !FPackageName::DoesPackageExist(PendingAsset.AssetData.PackageName.ToString(), &PendingAsset.Filename))
+		{
+			Fail(PendingAsset.AssetData, TEXT("package file not found"));
+			continue;
+		}
+
+		// The whole file goes, so every asset in it has to be part of the request
+		TArray<FAssetData> PackageAssets;
+		AssetRegistry.GetAssetsByPackageName(PendingAsset.AssetData.PackageName, PackageAssets, true);
+
+		if (PackageAssets.Num() > NumRequestedByPackage.FindRef(PendingAsset.AssetData.PackageName))
+		{
+			Fail(PendingAsset.AssetData, TEXT("its package holds other assets"));
+			continue;
+		}
+
+		AssetRegistry.GetReferencers(PendingAsset.AssetData.PackageName, PendingAsset.Referencers);
+		StageOutput.Add(MoveTemp(PendingAsset));
+	}
+
+	if (StageCursor < StageInput.Num())
+	{
+		return false;
+	}
+
+	FailExternallyReferencedAssets();
+	SortReferencersFirst();
+	return true;
+}
+
+bool FAssetDeletionPipeline::LoadBatch()
+{
+	// Requests are capped, so a cancel doesn't leave thousands of loads behind
+	for (; StageCursor < StageInput.Num() && StageCursor - NumLoaded < MaxLoadsInFlight; ++StageCursor)
+	{
+		const FAssetData& AssetData = StageInput[StageCursor].AssetData;
+
+		if (AssetData.IsAssetLoaded())
+		{
+			CompletedLoads->Add(StageCursor);
+			continue;
+		}
+
+		LoadPackageAsync(AssetData.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+			[LoadedIndices = CompletedLoads, AssetIndex = StageCursor](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type LoadResult)
+			{
+				LoadedIndices->Add(AssetIndex);
+			}
+		));
+	}
+
+	// Completion callbacks run from here, on the game thread, for the rest of the frame's budget at most
+	if (CompletedLoads->IsEmpty())
+	{
+		ProcessAsyncLoading(true, false, FMath::Max(FrameDeadline - FPlatformTime::Seconds(), 0.0));
+	}
+
+	const TArray<int32> LoadedIndices = MoveTemp(*CompletedLoads);
+	CompletedLoads->Reset();
+
+	for (const int32 Index : LoadedIndices)
+	{
+		// Never loads synchronously, a failed load stays null
+		StageInput[Index].Asset = StageInput[Index].AssetData.FastGetAsset(false);
+		++NumLoaded;
+	}
+
+	if (NumLoaded < StageInput.Num())
+	{
+		return false;
+	}
+
+	// Loads complete in any order, the output keeps the referencers first order of the validate stage
+	for (FPendingAsset& PendingAsset : StageInput)
+	{
+		if (!PendingAsset.Asset.IsValid())
+		{
+			Fail(PendingAsset.AssetData, TEXT("asset could not be loaded"));
+			continue;
+		}
+
+		StageOutput.Add(MoveTemp(PendingAsset));
+	}
+
+	return true;
+}
+
+bool FAssetDeletionPipeline::UnloadBatch()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+
+	const int32 BatchStart = StageCursor;
+	StageCursor = GetBatchEnd(BatchStart);
+
+	TArray<int32> BatchIndices;
+	TArray<UObject*> ObjectsToDelete;
+	TSet<FName> BatchPackages;
+
+	for (int32 Index = BatchStart; Index < StageCursor; ++Index)
+	{
+		FPendingAsset& PendingAsset = StageInput[Index];
+		UObject* AssetToDelete = PendingAsset.Asset.Get();
+
+		if (!AssetToDelete)
+		{
+			Fail(PendingAsset.AssetData, TEXT("asset was unloaded before it could be deleted"));
+			continue;
+		}
+
+		// Re-read the referencers, the project may have changed since the validate stage
+		PendingAsset.Referencers.Reset();
+		AssetRegistry.GetReferencers(PendingAsset.AssetData.PackageName, PendingAsset.Referencers);
+
+		AssetEditorSubsystem->CloseAllEditorsForAsset(AssetToDelete);
+		BatchIndices.Add(Index);
+		ObjectsToDelete.Add(AssetToDelete);
+		BatchPackages.Add(PendingAsset.AssetData.PackageName);
+	}
+
+	// One pass over the objects in memory for the whole batch, e.g. a loaded level or an unsaved object pointing at
+	// an asset. References from the batch itself and from assets unloaded earlier, which wait for collection, don't count
+	bool bReferencedByUndo = false;
+	TArray<UObject*> ExternalReferencers;
+	const TArray<UObject*> MemoryReferencers = ObjectsToDelete.IsEmpty()
+		? TArray<UObject*>()
+		: FReferencerFinder::GetAllReferencers(ObjectsToDelete, nullptr, EReferencerFinderFlags::SkipInnerReferences);
+
+	for (UObject* Referencer : MemoryReferencers)
+	{
+		if (Referencer == GEditor->Trans)
+		{
+			bReferencedByUndo = true;
+			continue;
+		}
+
+		const FName ReferencerPackage = Referencer->GetPackage()->GetFName();
+
+		if (!Referencer->IsGarbage() && !BatchPackages.Contains(ReferencerPackage) && !DeletedPackages.Contains(ReferencerPackage))
+		{
+			ExternalReferencers.Add(Referencer);
+		}
+	}
+
+	// Usually none, only then is each referencer asked which of the batch's assets it points at
+	for (UObject* Referencer : ExternalReferencers)
+	{
+		TArray<UObject*> ReferencedObjects;
+		FReferenceFinder ReferenceFinder(ReferencedObjects);
+		ReferenceFinder.FindReferences(Referencer);
+
+		for (UObject* ReferencedObject : ReferencedObjects)
+		{
+			const int32 BatchPosition = ObjectsToDelete.Find(ReferencedObject);
+
+			if (BatchPosition != INDEX_NONE && PendingPackages.Contains(StageInput[BatchIndices[BatchPosition]].AssetData.PackageName))
+			{
+				UE_LOG(LogUdemyCourse, Warning, TEXT("%s is referenced in memory by %s"), *ReferencedObject->GetPathName(), *Referencer->GetPathName());
+				Fail(StageInput[BatchIndices[BatchPosition]].AssetData, TEXT("still referenced in memory"));
+			}
+		}
+	}
+
+	// A failed asset stays, so whatever of the batch it references has to stay too. Referencers come first,
+	// so only the batch itself can hold such a pair. Repeat until nothing changes
+	bool bFailedAny = true;
+
+	while (bFailedAny)
+	{
+		bFailedAny = false;
+
+		for (int32 Position = BatchIndices.Num() - 1; Position >= 0; --Position)
+		{
+			const FPendingAsset& PendingAsset = StageInput[BatchIndices[Position]];
+
+			if (PendingPackages.Contains(PendingAsset.AssetData.PackageName))
+			{
+				const FName* KeptReferencer = FindKeptReferencer(PendingAsset.Referencers);
+
+				if (!KeptReferencer)
+				{
+					continue;
+				}
+
+				UE_LOG(LogUdemyCourse, Warning, TEXT("%s is referenced by %s"), *PendingAsset.AssetData.GetObjectPathString(), *KeptReferencer->ToString());
+				Fail(PendingAsset.AssetData, TEXT("still referenced"));
+			}
+
+			BatchIndices.RemoveAt(Position);
+			ObjectsToDelete.RemoveAt(Position);
+			bFailedAny = true;
+		}
+	}
+
+	// The undo buffer would otherwise keep the deleted objects alive
+	if (bReferencedByUndo && !ObjectsToDelete.IsEmpty())
+	{
+		GEditor->ResetTransaction(LOCTEXT("DeleteAssetsTransactionReset", "Delete Assets"));
+	}
+
+	for (int32 Position = 0; Position < BatchIndices.Num(); ++Position)
+	{
+		FPendingAsset& PendingAsset = StageInput[BatchIndices[Position]];
+		UObject* AssetToDelete = ObjectsToDelete[Position];
+		UPackage* Package = AssetToDelete->GetPackage();
+
+		// The registry only takes the live object, so the asset leaves it here rather than once its file is gone
+		FAssetRegistryModule::AssetDeleted(AssetToDelete);
+		AssetToDelete->ClearFlags(RF_Standalone | RF_Public);
+		AssetToDelete->MarkAsGarbage();
+
+		// Unsaved changes go with the asset, and the loader lets go of the file so it can be deleted
+		Package->SetDirtyFlag(false);
+		ResetLoaders(Package);
+
+		PendingPackages.Remove(PendingAsset.AssetData.PackageName);
+		DeletedPackages.Add(PendingAsset.AssetData.PackageName);
+		StageOutput.Add(MoveTemp(PendingAsset));
+	}
+
+	if (StageCursor < StageInput.Num())
+	{
+		return false;
+	}
+
+	// The one step that isn't sliced, a single collection for every unloaded asset instead of one per batch
+	if (!StageOutput.IsEmpty())
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return true;
+}
+
+bool FAssetDeletionPipeline::DeleteFilesBatch()
+{
+	const int32 BatchStart = StageCursor;
+	StageCursor = GetBatchEnd(BatchStart);
+
+	TArray<int32> BatchIndices;
+	TArray<FString> Filenames;
+
+	for (int32 Index = BatchStart; Index < StageCursor; ++Index)
+	{
+		const FPendingAsset& PendingAsset = StageInput[Index];
+
+		// A referencer whose file couldn't be deleted comes back, so what it references has to come back too
+		if (const FName* KeptReferencer = FindKeptReferencer(PendingAsset.Referencers))
+		{
+			UE_LOG(LogUdemyCourse, Warning, TEXT("%s is referenced by %s"), *PendingAsset.AssetData.GetObjectPathString(), *KeptReferencer->ToString());
+			Restore(PendingAsset, TEXT("a referencer could not be deleted"));
+			continue;
+		}
+
+		BatchIndices.Add(Index);
+		Filenames.Add(FPaths::ConvertRelativePathToFull(PendingAsset.Filename));
+	}
+
+	// Through source control when it is enabled, so the deletes end up in a changelist
+	if (!Filenames.IsEmpty() && ISourceControlModule::Get().IsEnabled())
+	{
+		USourceControlHelpers::MarkFilesForDelete(Filenames, true);
+	}
+
+	for (int32 Position = 0; Position < BatchIndices.Num(); ++Position)
+	{
+		FPendingAsset& PendingAsset = StageInput[BatchIndices[Position]];
+
+		// Files that aren't under source control are still there, they are deleted directly
+		if (IFileManager::Get().FileExists(*Filenames[Position]) && !IFileManager::Get().Delete(*Filenames[Position], false, true, true))
+		{
+			Restore(PendingAsset, TEXT("package file could not be deleted"));
+			continue;
+		}
+
+		StageOutput.Add(MoveTemp(PendingAsset));
+	}
+
+	return StageCursor >= StageInput.Num();
+}
+
+bool FAssetDeletionPipeline::UpdateRegistryBatch()
+{
+	// Files that stayed are scanned back in first, their assets load from disk again afterwards
+	if (!FilesToRescan.IsEmpty())
+	{
+		const int32 NumToScan = FMath::Min(BatchSize, FilesToRescan.Num());
+		const TArray<FString> FilesToScan(FilesToRescan.GetData() + FilesToRescan.Num() - NumToScan, NumToScan);
+		FilesToRescan.SetNum(FilesToRescan.Num() - NumToScan);
+
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().ScanFilesSynchronous(FilesToScan, true);
+		return false;
+	}
+
+	const int32 BatchEnd = FMath::Min(StageCursor + BatchSize, StageInput.Num());
+
+	for (; StageCursor < BatchEnd; ++StageCursor)
+	{
+		Result.DeletedAssets.Add(StageInput[StageCursor].AssetData);
+	}
+
+	return StageCursor >= StageInput.Num();
+}
+
+void FAssetDeletionPipeline::FailExternallyReferencedAssets()
+{
+	// A failed asset stays, so whatever it references has to stay too. Repeat until the set is closed
+	bool bFailedAny = true;
+
+	while (bFailedAny)
+	{
+		bFailedAny = false;
+
+		StageOutput.RemoveAll([this, &bFailedAny](const FPendingAsset& PendingAsset)
+		{
+			const FName* KeptReferencer = FindKeptReferencer(PendingAsset.Referencers);
+
+			if (!KeptReferencer)
+			{
+				return false;
+			}
+
+			UE_LOG(LogUdemyCourse, Warning, TEXT("%s is referenced by %s"), *PendingAsset.AssetData.GetObjectPathString(), *KeptReferencer->ToString());
+			Fail(PendingAsset.AssetData, TEXT("still referenced"));
+			bFailedAny = true;
+			return true;
+		});
+	}
+}
+
+void FAssetDeletionPipeline::SortReferencersFirst()
+{
+	TMap<FName, int32> IndexByPackage;
+	IndexByPackage.Reserve(StageOutput.Num());
+
+	for (int32 Index = 0; Index < StageOutput.Num(); ++Index)
+	{
+		IndexByPackage.Add(StageOutput[Index].AssetData.PackageName, Index);
+	}
+
+	TArray<TArray<int32>> ReferencedIndices;
+	ReferencedIndices.SetNum(StageOutput.Num());
+
+	for (int32 Index = 0; Index < StageOutput.Num(); ++Index)
+	{
+		for (const FName& Referencer : StageOutput[Index].Referencers)
+		{
+			const int32* ReferencerIndex = IndexByPackage.Find(Referencer);
+
+			if (ReferencerIndex && *ReferencerIndex != Index)
+			{
+				ReferencedIndices[*ReferencerIndex].Add(Index);
+			}
+		}
+	}
+
+	// Tarjan's algorithm, with an explicit stack since reference chains can be thousands of assets long.
+	// Each reference cycle comes out as one group, and every group after the groups it references
+	TArray<int32> VisitOrder;
+	VisitOrder.Init(INDEX_NONE, StageOutput.Num());
+	TArray<int32> LowLink;
+	LowLink.Init(0, StageOutput.Num());
+	TArray<bool> IsOnStack;
+	IsOnStack.Init(false, StageOutput.Num());
+
+	TArray<int32> VisitStack;
+	// Asset and the position in its ReferencedIndices to continue at
+	TArray<TPair<int32, int32>> CallStack;
+	TArray<TArray<int32>> Groups;
+	int32 NumVisited = 0;
+
+	auto Visit = [&VisitOrder, &LowLink, &IsOnStack, &VisitStack, &CallStack, &NumVisited](int32 Index)
+	{
+		VisitOrder[Index] = NumVisited;
+		LowLink[Index] = NumVisited;
+		++NumVisited;
+		VisitStack.Push(Index);
+		IsOnStack[Index] = true;
+		CallStack.Add({Index, 0});
+	};
+
+	for (int32 RootIndex = 0; RootIndex < StageOutput.Num(); ++RootIndex)
+	{
+		if (VisitOrder[RootIndex] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Visit(RootIndex);
+
+		while (!CallStack.IsEmpty())
+		{
+			const int32 Index = CallStack.Last().Key;
+			const int32 EdgeIndex = CallStack.Last().Value++;
+
+			if (EdgeIndex < ReferencedIndices[Index].Num())
+			{
+				const int32 ReferencedIndex = ReferencedIndices[Index][EdgeIndex];
+
+				if (VisitOrder[ReferencedIndex] == INDEX_NONE)
+				{
+					Visit(ReferencedIndex);
+				}
+				else if (IsOnStack[ReferencedIndex])
+				{
+					LowLink[Index] = FMath::Min(LowLink[Index], VisitOrder[ReferencedIndex]);
+				}
+
+				continue;
+			}
+
+			CallStack.Pop();
+
+			if (!CallStack.IsEmpty())
+			{
+				const int32 ReferencerIndex = CallStack.Last().Key;
+				LowLink[ReferencerIndex] = FMath::Min(LowLink[ReferencerIndex], LowLink[Index]);
+			}
+
+			if (LowLink[Index] == VisitOrder[Index])
+			{
+				TArray<int32>& Group = Groups.AddDefaulted_GetRef();
+				int32 MemberIndex = INDEX_NONE;
+
+				do
+				{
+					MemberIndex = VisitStack.Pop();
+					IsOnStack[MemberIndex] = false;
+					Group.Add(MemberIndex);
+				}
+				while (MemberIndex != Index);
+			}
+		}
+	}
+
+	// Groups come out referenced first, reversed they are referencers first
+	TArray<FPendingAsset> SortedAssets;
+	SortedAssets.Reserve(StageOutput.Num());
+
+	for (int32 GroupIndex = Groups.Num() - 1; GroupIndex >= 0; --GroupIndex)
+	{
+		for (const int32 Index : Groups[GroupIndex])
+		{
+			FPendingAsset& SortedAsset = SortedAssets.Add_GetRef(MoveTemp(StageOutput[Index]));
+			SortedAsset.GroupIndex = GroupIndex;
+		}
+	}
+
+	StageOutput = MoveTemp(SortedAssets);
+}
+
+int32 FAssetDeletionPipeline::GetBatchEnd(int32 BatchStart) const
+{
+	int32 BatchEnd = BatchStart;
+
+	while (BatchEnd < StageInput.Num())
+	{
+		int32 GroupEnd = BatchEnd + 1;
+
+		while (GroupEnd < StageInput.Num() && StageInput[GroupEnd].GroupIndex == StageInput[BatchEnd].GroupIndex)
+		{
+			++GroupEnd;
+		}
+
+		if (BatchEnd > BatchStart && GroupEnd - BatchStart > BatchSize)
+		{
+			break;
+		}
+
+		BatchEnd = GroupEnd;
+	}
+
+	return BatchEnd;
+}
+
+const FName* FAssetDeletionPipeline::FindKeptReferencer(const TArray<FName>& Referencers) const
+{
+	return Referencers.FindByPredicate([this](const FName& Referencer)
+	{
+		return !PendingPackages.Contains(Referencer) && !DeletedPackages.Contains(Referencer);
+	});
+}
+
+#pragma endregion
+
+void FAssetDeletionPipeline::EnterStage(EStage NewStage)
+{
+	Stage = NewStage;
+	StageInput = MoveTemp(StageOutput);
+	StageOutput.Reset();
+	StageCursor = 0;
+}
+
+void FAssetDeletionPipeline::CancelRemainingAssets()
+{
+	Result.bCancelled = true;
+
+	// Unloaded assets are finished by the remaining stages, only the rest of the unload stage's input stays
+	if (Stage == EStage::Unload)
+	{
+		for (int32 Index = StageCursor; Index < StageInput.Num(); ++Index)
+		{
+			Fail(StageInput[Index].AssetData, TEXT("cancelled"));
+		}
+
+		StageInput.SetNum(StageCursor);
+		return;
+	}
+
+	// Nothing was unloaded yet. The load stage keeps its items in StageInput until every load completed
+	for (const FPendingAsset& PendingAsset : StageInput)
+	{
+		Fail(PendingAsset.AssetData, TEXT("cancelled"));
+	}
+
+	for (const FPendingAsset& PendingAsset : StageOutput)
+	{
+		Fail(PendingAsset.AssetData, TEXT("cancelled"));
+	}
+
+	StageInput.Reset();
+	StageOutput.Reset();
+	EnterStage(EStage::Finished);
+}
+
+void FAssetDeletionPipeline::Fail(const FAssetData& AssetData, const TCHAR* Reason)
+{
+	PendingPackages.Remove(AssetData.PackageName);
+	DeletedPackages.Remove(AssetData.PackageName);
+	UE_LOG(LogUdemyCourse, Warning, TEXT("Asset was not deleted (%s): %s"), Reason, *AssetData.GetObjectPathString());
+	Result.FailedAssets.Add(AssetData);
+}
+
+void FAssetDeletionPipeline::Restore(const FPendingAsset& PendingAsset, const TCHAR* Reason)
+{
+	FilesToRescan.Add(PendingAsset.Filename);
+	Fail(PendingAsset.AssetData, Reason);
+}
+
+void FAssetDeletionPipeline::Finish()
+{
+	const FText Message = Result.FailedAssets.IsEmpty()
+		? FText::Format(LOCTEXT("DeletionFinished", "Deleted {0} asset(s)."), Result.DeletedAssets.Num())
+		: FText::Format(
+			LOCTEXT("DeletionFinishedWithFailures", "Deleted {0} asset(s), {1} not deleted. See the output log for details."),
+			Result.DeletedAssets.Num(),
+			Result.FailedAssets.Num()
+		);
+
+	DebugHeader::FinishPendingNotification(ProgressNotification, Message, Result.FailedAssets.IsEmpty());
+	ProgressNotification.Reset();
+
+	OnFinished.ExecuteIfBound(Result);
+}
+
+void FAssetDeletionPipeline::UpdateNotification()
+{
+	if (!ProgressNotification.IsValid() || bCancelRequested)
+	{
+		return;
+	}
+
+	ProgressNotification->SetText(FText::Format(
+		LOCTEXT("DeletionProgress", "Deleting assets - {0} ({1}/{2})"),
+		GetStageText(Stage),
+		Stage == EStage::Load ? NumLoaded : StageCursor,
+		StageInput.Num()
+	));
+}
+
+FText FAssetDeletionPipeline::GetStageText(EStage InStage)
+{
+	switch (InStage)
+	{
+	case EStage::Validate:
+		return LOCTEXT("ValidateStage", "Checking references");
+	case EStage::Load:
+		return LOCTEXT("LoadStage", "Loading");
+	case EStage::Unload:
+		return LOCTEXT("UnloadStage", "Unloading");
+	case EStage::DeleteFiles:
+		return LOCTEXT("DeleteFilesStage", "Deleting files");
+	case EStage::UpdateRegistry:
+		return LOCTEXT("UpdateRegistryStage", "Updating the asset registry");
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,235 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetJobScheduler.h"
+#include "DebugHeader.h"
+#include "Settings/UdemyCourseSettings.h"
+
+#define LOCTEXT_NAMESPACE "AssetJobScheduler"
+
+FAssetJobScheduler::~FAssetJobScheduler()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	// Destroyed while a job is still running, e.g. on module shutdown. The job isn't finished, the editor is going away
+	if (CurrentJob.IsValid())
+	{
+		DebugHeader::FinishPendingNotification(ProgressNotification, FText::Format(LOCTEXT("JobAborted", "{0} was aborted."), CurrentJob->GetDescription()), false);
+	}
+
+	// Listeners still waiting, e.g. a latent action keeping itself rooted, hear that their job won't finish.
+	// Merged jobs are reached through the broadcasts of the jobs they were merged into
+	TArray<TSharedRef<FAssetJob>> AbortedJobs = MoveTemp(PendingJobs);
+	PendingJobs.Reset();
+
+	if (CurrentJob.IsValid())
+	{
+		AbortedJobs.Insert(CurrentJob.ToSharedRef(), 0);
+		CurrentJob.Reset();
+	}
+
+	for (const TSharedRef<FAssetJob>& AbortedJob : AbortedJobs)
+	{
+		AbortedJob->OnFinished().Broadcast(true);
+	}
+}
+
+bool FAssetJobScheduler::Enqueue(const TSharedRef<FAssetJob>& Job)
+{
+	if (!Job->GetCoalesceKey().IsNone())
+	{
+		for (const TSharedRef<FAssetJob>& PendingJob : PendingJobs)
+		{
+			if (PendingJob->GetCoalesceKey() == Job->GetCoalesceKey() && PendingJob->Coalesce(*Job))
+			{
+				// Whoever waits on the merged job hears about the one doing the work
+				const FDelegateHandle ProgressHandle = PendingJob->OnProgress().AddLambda([Job](int32 NumStepsDone, int32 NumSteps)
+				{
+					Job->OnProgress().Broadcast(NumStepsDone, NumSteps);
+				});
+
+				const FDelegateHandle FinishedHandle = PendingJob->OnFinished().AddLambda([this, Job](bool bCancelled)
+				{
+					MergedJobs.RemoveAll([&Job](const FMergedJob& MergedJob) {return MergedJob.Job == Job;});
+					Job->OnFinished().Broadcast(bCancelled);
+				});
+
+				MergedJobs.Add({Job, PendingJob, ProgressHandle, FinishedHandle});
+
+				UE_LOG(LogUdemyCourse, Log, TEXT("%s coalesced into the queued job"), *Job->GetDescription().ToString());
+				return false;
+			}
+		}
+	}
+
+	PendingJobs.Add(Job);
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAssetJobScheduler::Tick));
+	}
+
+	UpdateNotification();
+	return true;
+}
+
+void FAssetJobScheduler::Cancel(const TSharedRef<FAssetJob>& Job)
+{
+	if (CurrentJob == Job)
+	{
+		CancelCurrent();
+		return;
+	}
+
+	if (PendingJobs.Remove(Job) > 0)
+	{
+		UE_LOG(LogUdemyCourse, Log, TEXT("%s removed from the queue"), *Job->GetDescription().ToString());
+		Job->OnFinished().Broadcast(true);
+		UpdateNotification();
+		return;
+	}
+
+	const int32 MergedIndex = MergedJobs.IndexOfByPredicate([&Job](const FMergedJob& MergedJob) {return MergedJob.Job == Job;});
+
+	if (MergedIndex != INDEX_NONE)
+	{
+		// Only this listener stops listening, the job it was merged into keeps running for the others
+		const FMergedJob MergedJob = MergedJobs[MergedIndex];
+		MergedJobs.RemoveAt(MergedIndex);
+		MergedJob.IntoJob->OnProgress().Remove(MergedJob.ProgressHandle);
+		MergedJob.IntoJob->OnFinished().Remove(MergedJob.FinishedHandle);
+
+		UE_LOG(LogUdemyCourse, Log, TEXT("%s detached from the job it was merged into"), *Job->GetDescription().ToString());
+		Job->OnFinished().Broadcast(true);
+	}
+}
+
+void FAssetJobScheduler::CancelCurrent()
+{
+	if (!CurrentJob.IsValid())
+	{
+		return;
+	}
+
+	bCancelRequested = true;
+
+	if (ProgressNotification.IsValid())
+	{
+		ProgressNotification->SetText(FText::Format(LOCTEXT("JobCancelling", "Cancelling {0}..."), CurrentJob->GetDescription()));
+	}
+}
+
+void FAssetJobScheduler::CancelAll()
+{
+	if (!PendingJobs.IsEmpty())
+	{
+		UE_LOG(LogUdemyCourse, Log, TEXT("Dropped %d queued job(s)"), PendingJobs.Num());
+
+		// Moved out first, a listener may queue another job
+		const TArray<TSharedRef<FAssetJob>> DroppedJobs = MoveTemp(PendingJobs);
+		PendingJobs.Reset();
+
+		for (const TSharedRef<FAssetJob>& DroppedJob : DroppedJobs)
+		{
+			DroppedJob->OnFinished().Broadcast(true);
+		}
+	}
+
+	CancelCurrent();
+}
+
+bool FAssetJobScheduler::Tick(float DeltaTime)
+{
+	const double BudgetSeconds = GetDefault<UUdemyCourseSettings>()->JobFrameBudgetMs / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// At least one step per frame, so a small budget still makes progress
+	do
+	{
+		if (!CurrentJob.IsValid() && !StartNextJob())
+		{
+			// Returning false removes the ticker
+			TickerHandle.Reset();
+			return false;
+		}
+
+		if (bCancelRequested || NextStep >= NumSteps)
+		{
+			FinishCurrentJob(bCancelRequested);
+			continue;
+		}
+
+		CurrentJob->ProcessStep(NextStep++);
+	}
+	while (FPlatformTime::Seconds() - StartTime < BudgetSeconds);
+
+	UpdateNotification();
+
+	// The last job of the frame may have just finished
+	if (CurrentJob.IsValid())
+	{
+		CurrentJob->OnProgress().Broadcast(NextStep, NumSteps);
+	}
+
+	return true;
+}
+
+bool FAssetJobScheduler::StartNextJob()
+{
+	if (PendingJobs.IsEmpty())
+	{
+		return false;
+	}
+
+	CurrentJob = PendingJobs[0];
+	PendingJobs.RemoveAt(0);
+	bCancelRequested = false;
+	NextStep = 0;
+	NumSteps = CurrentJob->Start();
+
+	ProgressNotification = DebugHeader::ShowPendingNotification(
+		CurrentJob->GetDescription(),
+		FSimpleDelegate::CreateRaw(this, &FAssetJobScheduler::CancelCurrent)
+	);
+
+	return true;
+}
+
+void FAssetJobScheduler::FinishCurrentJob(bool bCancelled)
+{
+	// Cleared first, Finish() may queue further jobs
+	const TSharedPtr<FAssetJob> FinishedJob = MoveTemp(CurrentJob);
+	CurrentJob.Reset();
+	bCancelRequested = false;
+
+	const FText Message = bCancelled
+		? FText::Format(LOCTEXT("JobCancelled", "{0} cancelled after {1} of {2} step(s)."), FinishedJob->GetDescription(), NextStep, NumSteps)
+		: FText::Format(LOCTEXT("JobFinished", "{0} finished."), FinishedJob->GetDescription());
+
+	DebugHeader::FinishPendingNotification(ProgressNotification, Message, !bCancelled);
+	ProgressNotification.Reset();
+
+	FinishedJob->Finish(bCancelled);
+	FinishedJob->OnProgress().Broadcast(NextStep, NumSteps);
+	FinishedJob->OnFinished().Broadcast(bCancelled);
+}
+
+void FAssetJobScheduler::UpdateNotification()
+{
+	if (!ProgressNotification.IsValid() || bCancelRequested)
+	{
+		return;
+	}
+
+	ProgressNotification->SetText(FText::Format(
+		LOCTEXT("JobProgress", "{0} ({1}/{2}), {3} more queued"),
+		CurrentJob->GetDescription(),
+		NextStep,
+		NumSteps,
+		PendingJobs.Num()
+	));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,75 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetPreloader.h"
+#include "DebugHeader.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/UObjectGlobals.h"
+
+bool FAssetPreloader::LoadAndProcess(const TArray<FAssetData>& Assets, TFunctionRef<void(int32 AssetIndex, UObject* Asset)> ProcessAsset, const FText& ProgressMessage)
+{
+	FScopedSlowTask SlowTask(Assets.Num(), ProgressMessage);
+	SlowTask.MakeDialogDelayed(0.5f, true);
+
+	// Shared with the load callbacks, which may still arrive after a cancel
+	TSharedRef<TArray<int32>> CompletedIndices = MakeShared<TArray<int32>>();
+	TMap<FName, TArray<int32>> IndicesByPackage;
+	int32 NumProcessed = 0;
+
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		if (Assets[Index].IsAssetLoaded())
+		{
+			CompletedIndices->Add(Index);
+		}
+		else
+		{
+			IndicesByPackage.FindOrAdd(Assets[Index].PackageName).Add(Index);
+		}
+	}
+
+	for (const TPair<FName, TArray<int32>>& PackageIndices : IndicesByPackage)
+	{
+		LoadPackageAsync(PackageIndices.Key.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+			[CompletedIndices, Indices = PackageIndices.Value](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				if (Result != EAsyncLoadingResult::Succeeded)
+				{
+					UE_LOG(LogUdemyCourse, Warning, TEXT("Could not load %s"), *PackageName.ToString());
+				}
+
+				CompletedIndices->Append(Indices);
+			}
+		));
+	}
+
+	while (NumProcessed < Assets.Num())
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			UE_LOG(LogUdemyCourse, Log, TEXT("Preloading cancelled after %d of %d asset(s)"), NumProcessed, Assets.Num());
+			return false;
+		}
+
+		// Completion callbacks run from here, on the game thread
+		if (CompletedIndices->IsEmpty())
+		{
+			ProcessAsyncLoading(true, false, LoadingTimeSliceSeconds);
+			SlowTask.TickProgress();
+			continue;
+		}
+
+		const TArray<int32> ReadyIndices = MoveTemp(*CompletedIndices);
+		CompletedIndices->Reset();
+
+		for (const int32 Index : ReadyIndices)
+		{
+			SlowTask.EnterProgressFrame();
+
+			// Never loads synchronously, a failed load stays null instead of being retried
+			ProcessAsset(Index, Assets[Index].FastGetAsset(false));
+			++NumProcessed;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,171 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetQuarantine.h"
+#include "ProcessData/AssetBatchRename.h"
+#include "DebugHeader.h"
+#include "Settings/UdemyCourseSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorAssetLibrary.h"
+#include "ObjectTools.h"
+
+#define LOCTEXT_NAMESPACE "AssetQuarantine"
+
+bool FAssetQuarantine::IsEnabled()
+{
+	return GetDefault<UUdemyCourseSettings>()->bQuarantineInsteadOfDelete;
+}
+
+FString FAssetQuarantine::GetQuarantinePath()
+{
+	return GetDefault<UUdemyCourseSettings>()->GetQuarantinePath();
+}
+
+bool FAssetQuarantine::IsInQuarantine(const FString& PackagePath)
+{
+	const FString QuarantinePath = GetQuarantinePath();
+	return PackagePath == QuarantinePath || (PackagePath.StartsWith(QuarantinePath) && PackagePath[QuarantinePath.Len()] == TEXT('/'));
+}
+
+FString FAssetQuarantine::GetQuarantinedFolder(const FString& ContentPath)
+{
+	return IsInQuarantine(ContentPath) ? ContentPath : GetQuarantinePath() + ContentPath;
+}
+
+FAssetDeletionResult FAssetQuarantine::QuarantineAssets(const TArray<FAssetData>& AssetsToQuarantine)
+{
+	FAssetDeletionResult Result;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const FString QuarantinePath = GetQuarantinePath();
+
+	TSet<FName> PackagesToQuarantine;
+
+	for (const FAssetData& AssetToQuarantine : AssetsToQuarantine)
+	{
+		PackagesToQuarantine.Add(AssetToQuarantine.PackageName);
+	}
+
+	TArray<FAssetData> AssetsToMove;
+	AssetsToMove.Reserve(AssetsToQuarantine.Num());
+
+	for (const FAssetData& AssetToQuarantine : AssetsToQuarantine)
+	{
+		if (!AssetToQuarantine.IsValid() || IsInQuarantine(AssetToQuarantine.PackagePath.ToString()))
+		{
+			Result.FailedAssets.Add(AssetToQuarantine);
+			continue;
+		}
+
+		// Same rule as deleting, purging the quarantine later must not break anything outside of it
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(AssetToQuarantine.PackageName, Referencers);
+
+		if (Referencers.ContainsByPredicate([&PackagesToQuarantine](const FName& Referencer) {return !PackagesToQuarantine.Contains(Referencer);}))
+		{
+			UE_LOG(LogUdemyCourse, Warning, TEXT("Asset was not quarantined (still referenced): %s"), *AssetToQuarantine.GetObjectPathString());
+			Result.FailedAssets.Add(AssetToQuarantine);
+			continue;
+		}
+
+		AssetsToMove.Add(AssetToQuarantine);
+	}
+
+	Result.DeletedAssets = MoveAssets(AssetsToMove, [&QuarantinePath](const FAssetData& AssetData)
+	{
+		return QuarantinePath + AssetData.PackagePath.ToString();
+	});
+
+	if (Result.DeletedAssets.Num() < AssetsToMove.Num())
+	{
+		TSet<FSoftObjectPath> MovedPaths;
+
+		for (const FAssetData& MovedAsset : Result.DeletedAssets)
+		{
+			MovedPaths.Add(MovedAsset.GetSoftObjectPath());
+		}
+
+		for (const FAssetData& AssetToMove : AssetsToMove)
+		{
+			if (!MovedPaths.Contains(AssetToMove.GetSoftObjectPath()))
+			{
+				Result.FailedAssets.Add(AssetToMove);
+			}
+		}
+	}
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Quarantined %d asset(s) into %s, %d failed"), Result.DeletedAssets.Num(), *QuarantinePath, Result.FailedAssets.Num());
+	return Result;
+}
+
+int32 FAssetQuarantine::RestoreFolder(const FString& QuarantinedFolder)
+{
+	if (!IsInQuarantine(QuarantinedFolder))
+	{
+		return 0;
+	}
+
+	const int32 QuarantinePathLen = GetQuarantinePath().Len();
+	const TArray<FAssetData> RestoredAssets = MoveAssets(GetAssetsInFolder(QuarantinedFolder), [QuarantinePathLen](const FAssetData& AssetData)
+	{
+		return AssetData.PackagePath.ToString().RightChop(QuarantinePathLen);
+	});
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Restored %d asset(s) from %s"), RestoredAssets.Num(), *QuarantinedFolder);
+	return RestoredAssets.Num();
+}
+
+int32 FAssetQuarantine::PurgeFolder(const FString& QuarantinedFolder)
+{
+	if (!IsInQuarantine(QuarantinedFolder))
+	{
+		return 0;
+	}
+
+	const TArray<FAssetData> AssetsToPurge = GetAssetsInFolder(QuarantinedFolder);
+
+	if (AssetsToPurge.IsEmpty())
+	{
+		return 0;
+	}
+
+	// One delete for the whole quarantine, references are gathered and garbage is collected once
+	const int32 NumPurgedAssets = ObjectTools::DeleteAssets(AssetsToPurge, true);
+
+	if (!UEditorAssetLibrary::DoesDirectoryHaveAssets(QuarantinedFolder, true))
+	{
+		UEditorAssetLibrary::DeleteDirectory(QuarantinedFolder);
+	}
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Purged %d of %d asset(s) from %s"), NumPurgedAssets, AssetsToPurge.Num(), *QuarantinedFolder);
+	return NumPurgedAssets;
+}
+
+TArray<FAssetData> FAssetQuarantine::GetAssetsInFolder(const FString& Folder)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(Folder));
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	// Redirectors are fixed up right after every move, any left over have nothing to restore
+	Assets.RemoveAll([](const FAssetData& AssetData) {return AssetData.IsRedirector();});
+	return Assets;
+}
+
+TArray<FAssetData> FAssetQuarantine::MoveAssets(const TArray<FAssetData>& AssetsToMove, TFunctionRef<FString(const FAssetData&)> GetNewPackagePath)
+{
+	TArray<FAssetBatchRenameItem> Items;
+	Items.Reserve(AssetsToMove.Num());
+
+	for (const FAssetData& AssetToMove : AssetsToMove)
+	{
+		Items.Add({AssetToMove, GetNewPackagePath(AssetToMove), AssetToMove.AssetName.ToString()});
+	}
+
+	return FAssetBatchRename::RenameAssets(Items, FText::Format(LOCTEXT("MovingAssets", "Moving {0} asset(s)..."), AssetsToMove.Num()));
+}
+
+#undef LOCTEXT_NAMESPACE
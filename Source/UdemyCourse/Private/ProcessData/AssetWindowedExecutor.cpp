@@ -0,0 +1,104 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/AssetWindowedExecutor.h"
+#include "DebugHeader.h"
+#include "Settings/UdemyCourseSettings.h"
+#include "Misc/ScopedSlowTask.h"
+#include "PackageTools.h"
+
+#define LOCTEXT_NAMESPACE "AssetWindowedExecutor"
+
+bool FAssetWindowedExecutor::ForEachWindow(int32 NumItems, TFunctionRef<bool(int32 WindowStart, int32 WindowCount, TArray<UPackage*>& OutPackagesToRelease)> ProcessWindow, const FText& ProgressMessage)
+{
+	if (NumItems <= 0)
+	{
+		return true;
+	}
+
+	const int32 WindowSize = GetWindowSize(NumItems);
+	const int32 NumWindows = FMath::DivideAndRoundUp(NumItems, WindowSize);
+
+	FScopedSlowTask SlowTask(NumWindows, ProgressMessage);
+	SlowTask.MakeDialogDelayed(0.5f, true);
+
+	TArray<UPackage*> PackagesToRelease;
+
+	for (int32 Window = 0; Window < NumWindows; ++Window)
+	{
+		if (Window > 0 && SlowTask.ShouldCancel())
+		{
+			UE_LOG(LogUdemyCourse, Log, TEXT("Cancelled after %d of %d window(s)"), Window, NumWindows);
+			return false;
+		}
+
+		SlowTask.EnterProgressFrame(1.f, NumWindows > 1
+			? FText::Format(LOCTEXT("WindowProgress", "{0} (window {1} of {2})"), ProgressMessage, Window + 1, NumWindows)
+			: ProgressMessage);
+
+		const int32 WindowStart = Window * WindowSize;
+		const bool bContinue = ProcessWindow(WindowStart, FMath::Min(WindowSize, NumItems - WindowStart), PackagesToRelease);
+
+		if (NumWindows > 1)
+		{
+			ReleasePackages(PackagesToRelease);
+			UE_LOG(LogUdemyCourse, Verbose, TEXT("Window %d of %d done, %llu MB physical memory in use"), Window + 1, NumWindows, FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024));
+		}
+
+		PackagesToRelease.Reset();
+
+		if (!bContinue)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FAssetWindowedExecutor::GetWindowSize(int32 NumItems)
+{
+	const int32 WindowSize = GetDefault<UUdemyCourseSettings>()->AssetWindowSize;
+	return WindowSize > 0 ? WindowSize : FMath::Max(NumItems, 1);
+}
+
+void FAssetWindowedExecutor::ReleasePackages(const TArray<UPackage*>& Packages)
+{
+	TArray<UPackage*> CleanPackages;
+	int32 NumDirty = 0;
+
+	for (UPackage* Package : Packages)
+	{
+		if (!IsValid(Package))
+		{
+			continue;
+		}
+
+		// Unloading would throw the changes away
+		if (Package->IsDirty())
+		{
+			++NumDirty;
+			continue;
+		}
+
+		CleanPackages.AddUnique(Package);
+	}
+
+	if (NumDirty > 0)
+	{
+		UE_LOG(LogUdemyCourse, Log, TEXT("%d package(s) with unsaved changes stay loaded"), NumDirty);
+	}
+
+	FText ErrorMessage;
+
+	// Unloading collects garbage itself, otherwise it is collected here so the references dropped by the window are freed
+	if (CleanPackages.IsEmpty())
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+	else if (!UPackageTools::UnloadPackages(CleanPackages, ErrorMessage))
+	{
+		UE_LOG(LogUdemyCourse, Warning, TEXT("%s"), *ErrorMessage.ToString());
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
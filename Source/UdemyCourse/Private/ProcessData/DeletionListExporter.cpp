@@ -0,0 +1,231 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/DeletionListExporter.h"
+#include "DebugHeader.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+FDeletionListExporter::EFormat FDeletionListExporter::GetFormatForFilename(const FString& Filename)
+{
+	return FPaths::GetExtension(Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase) ? EFormat::Json : EFormat::Csv;
+}
+
+bool FDeletionListExporter::ExportRows(const TArray<FDeletionListRowPtr>& Rows, const FString& Filename, EFormat Format)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+
+	if (!Writer)
+	{
+		UE_LOG(LogUdemyCourse, Error, TEXT("Could not open %s for writing"), *Filename);
+		return false;
+	}
+
+	FDeletionListExporter Exporter(*Writer);
+
+	if (Format == EFormat::Csv)
+	{
+		Exporter.Append(TEXT("Class,Name,ObjectPath,DiskSizeBytes,Referencers\r\n"));
+
+		for (const FDeletionListRowPtr& Row : Rows)
+		{
+			Exporter.WriteCsvRow(*Row);
+		}
+	}
+	else
+	{
+		Exporter.Append(TEXT("["));
+
+		for (int32 Index = 0; Index < Rows.Num(); ++Index)
+		{
+			Exporter.WriteJsonRow(*Rows[Index], Index == 0);
+		}
+
+		Exporter.Append(TEXT("\n]\n"));
+	}
+
+	Exporter.Flush();
+
+	// Close() reports errors of the last write too
+	const bool bSucceeded = Writer->Close() && !Writer->IsError();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogUdemyCourse, Error, TEXT("Writing %s failed"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Exported %d row(s) to %s"), Rows.Num(), *Filename);
+	return true;
+}
+
+FDeletionListExporter::FDeletionListExporter(FArchive& InWriter)
+	: Writer(InWriter)
+{
+	Buffer.Reserve(BufferSize);
+}
+
+void FDeletionListExporter::WriteCsvRow(const FDeletionListRow& Row)
+{
+	Scratch.Reset();
+	Row.GetClassName().AppendString(Scratch);
+	AppendCsvField(Scratch);
+	Append(TEXT(","));
+
+	Scratch.Reset();
+	Row.AssetData->AssetName.AppendString(Scratch);
+	AppendCsvField(Scratch);
+	Append(TEXT(","));
+
+	Scratch.Reset();
+	Row.AssetData->AppendObjectPath(Scratch);
+	AppendCsvField(Scratch);
+
+	// Unknown sizes are left empty rather than written as -1
+	Scratch.Reset();
+	Scratch << TEXT(',');
+
+	if (Row.DiskSize != INDEX_NONE)
+	{
+		Scratch << Row.DiskSize;
+	}
+
+	Scratch << TEXT(',') << Row.ReferencerCount << TEXT("\r\n");
+	Append(Scratch);
+}
+
+void FDeletionListExporter::WriteJsonRow(const FDeletionListRow& Row, bool bIsFirst)
+{
+	Append(bIsFirst ? TEXT("\n\t{\"class\": ") : TEXT(",\n\t{\"class\": "));
+
+	Scratch.Reset();
+	Row.GetClassName().AppendString(Scratch);
+	AppendJsonString(Scratch);
+	Append(TEXT(", \"name\": "));
+
+	Scratch.Reset();
+	Row.AssetData->AssetName.AppendString(Scratch);
+	AppendJsonString(Scratch);
+	Append(TEXT(", \"objectPath\": "));
+
+	Scratch.Reset();
+	Row.AssetData->AppendObjectPath(Scratch);
+	AppendJsonString(Scratch);
+
+	Scratch.Reset();
+	Scratch << TEXT(", \"diskSizeBytes\": ");
+
+	if (Row.DiskSize != INDEX_NONE)
+	{
+		Scratch << Row.DiskSize;
+	}
+	else
+	{
+		Scratch << TEXT("null");
+	}
+
+	Scratch << TEXT(", \"referencers\": ") << Row.ReferencerCount << TEXT('}');
+	Append(Scratch);
+}
+
+void FDeletionListExporter::Append(FStringView Text)
+{
+	if (Text.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 ConvertedLength = FPlatformString::ConvertedLength<UTF8CHAR>(Text.GetData(), Text.Len());
+
+	if (Buffer.Num() + ConvertedLength > BufferSize)
+	{
+		Flush();
+	}
+
+	// Converted straight into the buffer, the slack only grows past BufferSize for a single oversized value
+	const int32 Offset = Buffer.Num();
+	Buffer.AddUninitialized(ConvertedLength);
+	FPlatformString::Convert(Buffer.GetData() + Offset, ConvertedLength, Text.GetData(), Text.Len());
+}
+
+void FDeletionListExporter::AppendCsvField(FStringView Field)
+{
+	int32 SpecialIndex = INDEX_NONE;
+	const bool bNeedsQuotes = Field.FindChar(TEXT(','), SpecialIndex) || Field.FindChar(TEXT('"'), SpecialIndex)
+		|| Field.FindChar(TEXT('\n'), SpecialIndex) || Field.FindChar(TEXT('\r'), SpecialIndex);
+
+	if (!bNeedsQuotes)
+	{
+		Append(Field);
+		return;
+	}
+
+	// RFC 4180, the field is quoted and quotes inside it are doubled
+	Append(TEXT("\""));
+	int32 QuoteIndex = INDEX_NONE;
+
+	while (Field.FindChar(TEXT('"'), QuoteIndex))
+	{
+		Append(Field.Left(QuoteIndex + 1));
+		Append(TEXT("\""));
+		Field.RightChopInline(QuoteIndex + 1);
+	}
+
+	Append(Field);
+	Append(TEXT("\""));
+}
+
+void FDeletionListExporter::AppendJsonString(FStringView Value)
+{
+	Append(TEXT("\""));
+
+	// Runs of plain characters are appended in one go, only the characters in between are escaped
+	int32 RunStart = 0;
+
+	for (int32 Index = 0; Index < Value.Len(); ++Index)
+	{
+		const TCHAR Char = Value[Index];
+
+		if (Char != TEXT('"') && Char != TEXT('\\') && Char >= 0x20)
+		{
+			continue;
+		}
+
+		Append(Value.Mid(RunStart, Index - RunStart));
+
+		switch (Char)
+		{
+		case TEXT('"'):
+			Append(TEXT("\\\""));
+			break;
+		case TEXT('\\'):
+			Append(TEXT("\\\\"));
+			break;
+		case TEXT('\n'):
+			Append(TEXT("\\n"));
+			break;
+		case TEXT('\r'):
+			Append(TEXT("\\r"));
+			break;
+		case TEXT('\t'):
+			Append(TEXT("\\t"));
+			break;
+		default:
+			Append(*FString::Printf(TEXT("\\u%04x"), Char));
+			break;
+		}
+
+		RunStart = Index + 1;
+	}
+
+	Append(Value.Mid(RunStart));
+	Append(TEXT("\""));
+}
+
+void FDeletionListExporter::Flush()
+{
+	if (!Buffer.IsEmpty())
+	{
+		Writer.Serialize(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/NamingConvention.h"
+#include "Settings/UdemyCourseSettings.h"
+
+const FString FNamingConvention::EmptyAffix;
+
+FNamingConvention::FNamingConvention(const UUdemyCourseSettings& Settings)
+{
+	for (const FAssetNamingClassRule& ClassRule : Settings.ClassRules)
+	{
+		const FTopLevelAssetPath ClassPath = ClassRule.AssetClass.GetAssetPath();
+
+		if (ClassPath.IsNull())
+		{
+			continue;
+		}
+
+		// A later rule for the same class replaces the earlier one, like a config override would
+		ClassRuleIndices.Add(ClassPath, ClassRules.Add({ClassRule.Prefix, ClassRule.Suffix, ClassRule.StripPrefixes, ClassRule.StripSuffixes}));
+	}
+
+	for (const FAssetNamingFolderRule& FolderRule : Settings.FolderRules)
+	{
+		FString Folder = FolderRule.Folder.Path;
+		Folder.RemoveFromEnd(TEXT("/"));
+
+		if (!Folder.IsEmpty())
+		{
+			FolderRuleIndices.Add(FName(Folder), FolderRules.Add({FolderRule.Prefix, FolderRule.Suffix}));
+		}
+	}
+
+	// Characters and a-z style ranges
+	const FString& AllowedCharacters = Settings.AllowedCharacters;
+
+	for (int32 Index = 0; Index < AllowedCharacters.Len(); ++Index)
+	{
+		TCHAR First = AllowedCharacters[Index];
+		TCHAR Last = First;
+
+		if (Index + 2 < AllowedCharacters.Len() && AllowedCharacters[Index + 1] == TEXT('-'))
+		{
+			Last = AllowedCharacters[Index + 2];
+			Index += 2;
+		}
+
+		for (uint32 Character = First; Character <= static_cast<uint32>(Last) && Character < 128; ++Character)
+		{
+			AllowedCharacterMask[Character >> 6] |= uint64(1) << (Character & 63);
+		}
+	}
+}
+
+bool FNamingConvention::HasRule(const FAssetData& AssetData)
+{
+	const FEffectiveRule Rule = FindRule(AssetData);
+	return Rule.ClassRule || Rule.Prefix != &EmptyAffix || Rule.Suffix != &EmptyAffix;
+}
+
+ENamingIssue FNamingConvention::Validate(const FAssetData& AssetData)
+{
+	ENamingIssue Issues = ENamingIssue::None;
+
+	// Built on the stack, so checking a name doesn't allocate
+	TStringBuilder<NAME_SIZE> NameBuilder;
+	AssetData.AssetName.AppendString(NameBuilder);
+	const FStringView Name = NameBuilder;
+
+	const FEffectiveRule Rule = FindRule(AssetData);
+
+	if (!Name.StartsWith(*Rule.Prefix, ESearchCase::CaseSensitive))
+	{
+		Issues |= ENamingIssue::MissingPrefix;
+	}
+
+	if (!Name.EndsWith(*Rule.Suffix, ESearchCase::CaseSensitive))
+	{
+		Issues |= ENamingIssue::MissingSuffix;
+	}
+
+	for (const TCHAR Character : Name)
+	{
+		if (!IsAllowedCharacter(Character))
+		{
+			Issues |= ENamingIssue::InvalidCharacters;
+			break;
+		}
+	}
+
+	return Issues;
+}
+
+FString FNamingConvention::MakeConformingName(const FAssetData& AssetData, const FString& BaseName)
+{
+	const FEffectiveRule Rule = FindRule(AssetData);
+	FString Name = BaseName;
+
+	if (Rule.ClassRule)
+	{
+		for (const FString& StripPrefix : Rule.ClassRule->StripPrefixes)
+		{
+			Name.RemoveFromStart(StripPrefix, ESearchCase::CaseSensitive);
+		}
+
+		for (const FString& StripSuffix : Rule.ClassRule->StripSuffixes)
+		{
+			Name.RemoveFromEnd(StripSuffix, ESearchCase::CaseSensitive);
+		}
+	}
+
+	for (TCHAR& Character : Name)
+	{
+		if (!IsAllowedCharacter(Character))
+		{
+			Character = TEXT('_');
+		}
+	}
+
+	if (!Name.StartsWith(*Rule.Prefix, ESearchCase::CaseSensitive))
+	{
+		Name = *Rule.Prefix + Name;
+	}
+
+	if (!Name.EndsWith(*Rule.Suffix, ESearchCase::CaseSensitive))
+	{
+		Name += *Rule.Suffix;
+	}
+
+	return Name;
+}
+
+FString FNamingConvention::DescribeIssues(const FAssetData& AssetData, ENamingIssue Issues)
+{
+	const FEffectiveRule Rule = FindRule(AssetData);
+	TArray<FString> Descriptions;
+
+	if (EnumHasAnyFlags(Issues, ENamingIssue::MissingPrefix))
+	{
+		Descriptions.Add(FString::Printf(TEXT("missing prefix %s"), **Rule.Prefix));
+	}
+
+	if (EnumHasAnyFlags(Issues, ENamingIssue::MissingSuffix))
+	{
+		Descriptions.Add(FString::Printf(TEXT("missing suffix %s"), **Rule.Suffix));
+	}
+
+	if (EnumHasAnyFlags(Issues, ENamingIssue::InvalidCharacters))
+	{
+		Descriptions.Add(TEXT("invalid characters"));
+	}
+
+	return FString::Join(Descriptions, TEXT(", "));
+}
+
+FNamingConvention::FEffectiveRule FNamingConvention::FindRule(const FAssetData& AssetData)
+{
+	FEffectiveRule Rule;
+
+	const int32 ClassRuleIndex = FindClassRuleIndex(AssetData.AssetClassPath);
+	const int32 FolderRuleIndex = FindFolderRuleIndex(AssetData.PackagePath);
+	const FCompiledFolderRule* FolderRule = FolderRuleIndex != INDEX_NONE ? &FolderRules[FolderRuleIndex] : nullptr;
+
+	Rule.ClassRule = ClassRuleIndex != INDEX_NONE ? &ClassRules[ClassRuleIndex] : nullptr;
+	Rule.Prefix = Rule.ClassRule ? &Rule.ClassRule->Prefix : &EmptyAffix;
+	Rule.Suffix = Rule.ClassRule ? &Rule.ClassRule->Suffix : &EmptyAffix;
+
+	// Folder rules only override the affixes they set
+	if (FolderRule && !FolderRule->Prefix.IsEmpty())
+	{
+		Rule.Prefix = &FolderRule->Prefix;
+	}
+
+	if (FolderRule && !FolderRule->Suffix.IsEmpty())
+	{
+		Rule.Suffix = &FolderRule->Suffix;
+	}
+
+	return Rule;
+}
+
+int32 FNamingConvention::FindClassRuleIndex(const FTopLevelAssetPath& ClassPath)
+{
+	if (const int32* ResolvedIndex = ResolvedClassRules.Find(ClassPath))
+	{
+		return *ResolvedIndex;
+	}
+
+	// The closest class in the hierarchy with a rule wins
+	int32 RuleIndex = INDEX_NONE;
+
+	for (const FTopLevelAssetPath& AncestorPath : ClassHierarchy.GetClassHierarchy(ClassPath))
+	{
+		if (const int32* AncestorRuleIndex = ClassRuleIndices.Find(AncestorPath))
+		{
+			RuleIndex = *AncestorRuleIndex;
+			break;
+		}
+	}
+
+	return ResolvedClassRules.Add(ClassPath, RuleIndex);
+}
+
+int32 FNamingConvention::FindFolderRuleIndex(FName PackagePath)
+{
+	if (FolderRuleIndices.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ResolvedIndex = ResolvedFolderRules.Find(PackagePath))
+	{
+		return *ResolvedIndex;
+	}
+
+	// Walk up the folders, the deepest configured one wins
+	int32 RuleIndex = INDEX_NONE;
+	FString Folder = PackagePath.ToString();
+
+	while (!Folder.IsEmpty())
+	{
+		if (const int32* FolderRuleIndex = FolderRuleIndices.Find(FName(Folder, FNAME_Find)))
+		{
+			RuleIndex = *FolderRuleIndex;
+			break;
+		}
+
+		int32 SlashIndex = INDEX_NONE;
+
+		if (!Folder.FindLastChar(TEXT('/'), SlashIndex) || SlashIndex == 0)
+		{
+			break;
+		}
+
+		Folder.LeftInline(SlashIndex);
+	}
+
+	return ResolvedFolderRules.Add(PackagePath, RuleIndex);
+}
+
+bool FNamingConvention::IsAllowedCharacter(TCHAR Character) const
+{
+	const uint32 Code = static_cast<uint32>(Character);
+	return Code < 128 && (AllowedCharacterMask[Code >> 6] & (uint64(1) << (Code & 63))) != 0;
+}
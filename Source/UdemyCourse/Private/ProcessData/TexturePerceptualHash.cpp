@@ -0,0 +1,321 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "ProcessData/TexturePerceptualHash.h"
+#include "DebugHeader.h"
+#include "ProcessData/AssetPreloader.h"
+#include "ProcessData/AssetWindowedExecutor.h"
+#include "Algo/Sort.h"
+#include "Engine/Texture.h"
+#include "HAL/FileManager.h"
+#include "ImageCore.h"
+#include "Math/VectorRegister.h"
+#include "Misc/PackageName.h"
+
+#define LOCTEXT_NAMESPACE "TexturePerceptualHash"
+
+namespace TexturePerceptualHash
+{
+	/** dHash compares each cell with its right neighbour, so the grid has one extra column */
+	static constexpr int32 HashRows = 8;
+	static constexpr int32 HashColumns = 9;
+	/** Source art is resized to this first, so the cell kernel runs over a fixed, small pixel count */
+	static constexpr int32 ReducedSize = 64;
+	static constexpr int32 BandBits = 8;
+	static constexpr int32 NumBands = 64 / BandBits;
+
+	/** Union-find over hash indices, with path halving */
+	int32 FindRoot(TArray<int32>& Parents, int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+
+		return Index;
+	}
+}
+
+TArray<TOptional<uint64>> FTexturePerceptualHashCache::GetHashes(const TArray<FAssetData>& Assets, bool* bOutCancelled)
+{
+	TArray<TOptional<uint64>> Hashes;
+	Hashes.SetNum(Assets.Num());
+
+	if (bOutCancelled)
+	{
+		*bOutCancelled = false;
+	}
+
+	// Packages whose source GUID is unknown or stale, the texture has to be loaded for those
+	TArray<TPair<int32, FDateTime>> TexturesToLoad;
+
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		const FAssetData& Asset = Assets[Index];
+		FString Filename;
+
+		if (!Asset.IsInstanceOf(UTexture::StaticClass()) || !FPackageName::DoesPackageExist(Asset.PackageName.ToString(), &Filename))
+		{
+			continue;
+		}
+
+		const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*Filename);
+		const FPackageSourceId* PackageSourceId = SourceIdsByPackage.Find(Asset.PackageName);
+		const uint64* CachedHash = PackageSourceId && PackageSourceId->Timestamp == Timestamp ? HashesBySourceId.Find(PackageSourceId->SourceId) : nullptr;
+
+		if (CachedHash)
+		{
+			Hashes[Index] = *CachedHash;
+			continue;
+		}
+
+		TexturesToLoad.Emplace(Index, Timestamp);
+	}
+
+	if (TexturesToLoad.IsEmpty())
+	{
+		return Hashes;
+	}
+
+	// Loaded through the async loader one window at a time. The executor only unloads between windows,
+	// but nothing but the hashes is kept, so a selection fitting in a single window is unloaded here as well
+	const bool bSingleWindow = FAssetWindowedExecutor::GetWindowSize(TexturesToLoad.Num()) >= TexturesToLoad.Num();
+	TArray<UPackage*> SingleWindowPackages;
+
+	const bool bCompleted = FAssetWindowedExecutor::ForEachWindow(TexturesToLoad.Num(), [this, &Assets, &TexturesToLoad, &Hashes, bSingleWindow, &SingleWindowPackages](int32 WindowStart, int32 WindowCount, TArray<UPackage*>& OutPackagesToRelease)
+	{
+		TArray<UPackage*>& LoadedPackages = bSingleWindow ? SingleWindowPackages : OutPackagesToRelease;
+		const TArrayView<const TPair<int32, FDateTime>> WindowTextures = TArrayView<const TPair<int32, FDateTime>>(TexturesToLoad).Slice(WindowStart, WindowCount);
+		TArray<FAssetData> WindowAssets;
+		TArray<bool> WasLoaded;
+		WindowAssets.Reserve(WindowCount);
+		WasLoaded.Reserve(WindowCount);
+
+		for (const TPair<int32, FDateTime>& TextureToLoad : WindowTextures)
+		{
+			WindowAssets.Add(Assets[TextureToLoad.Key]);
+			WasLoaded.Add(Assets[TextureToLoad.Key].IsAssetLoaded());
+		}
+
+		return FAssetPreloader::LoadAndProcess(WindowAssets, [this, &WindowTextures, &WasLoaded, &Hashes, &LoadedPackages](int32 AssetIndex, UObject* Asset)
+		{
+			UTexture* Texture = Cast<UTexture>(Asset);
+
+			if (!Texture)
+			{
+				return;
+			}
+
+			// Textures the user already had loaded stay loaded
+			if (!WasLoaded[AssetIndex])
+			{
+				LoadedPackages.Add(Texture->GetPackage());
+			}
+
+			if (Texture->Source.IsValid())
+			{
+				const TPair<int32, FDateTime>& TextureToLoad = WindowTextures[AssetIndex];
+				Hashes[TextureToLoad.Key] = HashTexture(Texture, TextureToLoad.Value);
+			}
+		}, FText::Format(LOCTEXT("LoadingTextures", "Loading {0} texture(s)..."), WindowCount));
+	}, FText::Format(LOCTEXT("HashingTextures", "Hashing {0} texture(s)..."), TexturesToLoad.Num()));
+
+	if (!SingleWindowPackages.IsEmpty())
+	{
+		FAssetWindowedExecutor::ReleasePackages(SingleWindowPackages);
+	}
+
+	if (bOutCancelled)
+	{
+		*bOutCancelled = !bCompleted;
+	}
+
+	return Hashes;
+}
+
+TOptional<uint64> FTexturePerceptualHashCache::HashTexture(UTexture* Texture, const FDateTime& PackageTimestamp)
+{
+	// Duplicated or re-saved textures keep their source GUID, so their hash is only computed once
+	const FGuid SourceId = Texture->Source.GetId();
+	SourceIdsByPackage.Add(Texture->GetPackage()->GetFName(), {PackageTimestamp, SourceId});
+
+	if (const uint64* CachedHash = HashesBySourceId.Find(SourceId))
+	{
+		return *CachedHash;
+	}
+
+	uint64 Hash = 0;
+
+	if (!ComputeHash(Texture, Hash))
+	{
+		return TOptional<uint64>();
+	}
+
+	HashesBySourceId.Add(SourceId, Hash);
+	return Hash;
+}
+
+bool FTexturePerceptualHashCache::ComputeHash(UTexture* Texture, uint64& OutHash)
+{
+	using namespace TexturePerceptualHash;
+
+	FImage SourceImage;
+
+	if (!Texture->Source.GetMipImage(SourceImage, 0))
+	{
+		UE_LOG(LogUdemyCourse, Warning, TEXT("Could not read the source art of %s"), *Texture->GetPathName());
+		return false;
+	}
+
+	// Resolution and pixel format of the source don't matter past this point
+	FImage ReducedImage;
+	SourceImage.ResizeTo(ReducedImage, ReducedSize, ReducedSize, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+	const TArrayView64<FLinearColor> Pixels = ReducedImage.AsRGBA32F();
+
+	// Box filter into the hash grid, four channels summed per instruction
+	VectorRegister4Float CellSums[HashRows * HashColumns];
+	int32 CellCounts[HashRows * HashColumns] = {};
+
+	for (VectorRegister4Float& CellSum : CellSums)
+	{
+		CellSum = VectorZeroFloat();
+	}
+
+	int32 ColumnCells[ReducedSize];
+
+	for (int32 X = 0; X < ReducedSize; ++X)
+	{
+		ColumnCells[X] = X * HashColumns / ReducedSize;
+	}
+
+	for (int32 Y = 0; Y < ReducedSize; ++Y)
+	{
+		const int32 RowCellOffset = (Y * HashRows / ReducedSize) * HashColumns;
+		const FLinearColor* RowPixels = &Pixels[Y * ReducedSize];
+
+		for (int32 X = 0; X < ReducedSize; ++X)
+		{
+			const int32 Cell = RowCellOffset + ColumnCells[X];
+			CellSums[Cell] = VectorAdd(CellSums[Cell], VectorLoad(&RowPixels[X].R));
+			++CellCounts[Cell];
+		}
+	}
+
+	// Rec. 709 luminance of the linear colour, alpha is ignored
+	const VectorRegister4Float LumaWeights = MakeVectorRegisterFloat(0.2126f, 0.7152f, 0.0722f, 0.f);
+	float CellLuma[HashRows * HashColumns];
+
+	for (int32 Cell = 0; Cell < HashRows * HashColumns; ++Cell)
+	{
+		CellLuma[Cell] = VectorGetComponent(VectorDot3(CellSums[Cell], LumaWeights), 0) / FMath::Max(CellCounts[Cell], 1);
+	}
+
+	OutHash = 0;
+
+	for (int32 Row = 0; Row < HashRows; ++Row)
+	{
+		for (int32 Column = 0; Column < HashColumns - 1; ++Column)
+		{
+			const int32 Cell = Row * HashColumns + Column;
+
+			if (CellLuma[Cell] < CellLuma[Cell + 1])
+			{
+				OutHash |= uint64(1) << (Row * (HashColumns - 1) + Column);
+			}
+		}
+	}
+
+	return true;
+}
+
+void FTexturePerceptualHashCache::FindClusters(const TArray<uint64>& Hashes, TArray<int32>& OutClusterIds, int32 MaxDistance)
+{
+	using namespace TexturePerceptualHash;
+
+	// Identical hashes are merged first, they are the most common near-duplicates and need no comparison
+	TArray<uint64> UniqueHashes;
+	TArray<int32> UniqueIndices;
+	TMap<uint64, int32> UniqueIndexByHash;
+	UniqueIndices.Reserve(Hashes.Num());
+
+	for (const uint64 Hash : Hashes)
+	{
+		int32& UniqueIndex = UniqueIndexByHash.FindOrAdd(Hash, INDEX_NONE);
+
+		if (UniqueIndex == INDEX_NONE)
+		{
+			UniqueIndex = UniqueHashes.Add(Hash);
+		}
+
+		UniqueIndices.Add(UniqueIndex);
+	}
+
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(UniqueHashes.Num());
+
+	for (int32 Index = 0; Index < Parents.Num(); ++Index)
+	{
+		Parents[Index] = Index;
+	}
+
+	// Hashes within MaxDistance < NumBands bits share at least one whole band, so only equal band runs are compared
+	TArray<int32> Order;
+	Order.SetNumUninitialized(UniqueHashes.Num());
+
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		const int32 Shift = Band * BandBits;
+		auto GetBand = [&UniqueHashes, Shift](int32 Index) {return (UniqueHashes[Index] >> Shift) & 0xFF;};
+
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			Order[Index] = Index;
+		}
+
+		Algo::SortBy(Order, GetBand);
+
+		for (int32 RunStart = 0; RunStart < Order.Num();)
+		{
+			int32 RunEnd = RunStart + 1;
+
+			while (RunEnd < Order.Num() && GetBand(Order[RunEnd]) == GetBand(Order[RunStart]))
+			{
+				++RunEnd;
+			}
+
+			for (int32 A = RunStart; A < RunEnd; ++A)
+			{
+				for (int32 B = A + 1; B < RunEnd; ++B)
+				{
+					if (FMath::CountBits(UniqueHashes[Order[A]] ^ UniqueHashes[Order[B]]) <= uint64(MaxDistance))
+					{
+						Parents[FindRoot(Parents, Order[A])] = FindRoot(Parents, Order[B]);
+					}
+				}
+			}
+
+			RunStart = RunEnd;
+		}
+	}
+
+	// Only sets with at least two textures are clusters
+	TMap<int32, int32> NumMembersByRoot;
+
+	for (const int32 UniqueIndex : UniqueIndices)
+	{
+		++NumMembersByRoot.FindOrAdd(FindRoot(Parents, UniqueIndex));
+	}
+
+	TMap<int32, int32> ClusterIdByRoot;
+	OutClusterIds.SetNumUninitialized(Hashes.Num());
+
+	for (int32 Index = 0; Index < Hashes.Num(); ++Index)
+	{
+		const int32 Root = FindRoot(Parents, UniqueIndices[Index]);
+		OutClusterIds[Index] = NumMembersByRoot.FindChecked(Root) > 1
+			? ClusterIdByRoot.FindOrAdd(Root, ClusterIdByRoot.Num())
+			: INDEX_NONE;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,63 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "Settings/UdemyCourseSettings.h"
+#include "Engine/Blueprint.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialFunctionInterface.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundWave.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "NiagaraSystem.h"
+#include "NiagaraEmitter.h"
+
+namespace UdemyCourseSettings
+{
+	static const TCHAR* DefaultQuarantinePath = TEXT("/Game/_Quarantine");
+}
+
+UUdemyCourseSettings::UUdemyCourseSettings()
+{
+	QuarantinePath.Path = UdemyCourseSettings::DefaultQuarantinePath;
+
+	// The plugin's original prefix table, a project overrides it in DefaultEditor.ini
+	auto AddClassRule = [this](const FSoftClassPath& AssetClass, const TCHAR* Prefix)
+	{
+		const int32 RuleIndex = ClassRules.AddDefaulted();
+		ClassRules[RuleIndex].AssetClass = AssetClass;
+		ClassRules[RuleIndex].Prefix = Prefix;
+		return RuleIndex;
+	};
+
+	AddClassRule(UBlueprint::StaticClass(), TEXT("BP_"));
+	AddClassRule(UStaticMesh::StaticClass(), TEXT("SM_"));
+	AddClassRule(UMaterial::StaticClass(), TEXT("M_"));
+	const int32 MaterialInstanceRule = AddClassRule(UMaterialInstanceConstant::StaticClass(), TEXT("MI_"));
+	AddClassRule(UMaterialFunctionInterface::StaticClass(), TEXT("MF_"));
+	AddClassRule(UParticleSystem::StaticClass(), TEXT("PS_"));
+	AddClassRule(USoundCue::StaticClass(), TEXT("SC_"));
+	AddClassRule(USoundWave::StaticClass(), TEXT("SW_"));
+	AddClassRule(UTexture::StaticClass(), TEXT("T_"));
+	AddClassRule(UUserWidget::StaticClass(), TEXT("WBP_"));
+	// Widget Blueprint assets are of the editor-only asset class, named by path to avoid linking UMGEditor
+	AddClassRule(FSoftClassPath(TEXT("/Script/UMGEditor.WidgetBlueprint")), TEXT("WBP_"));
+	AddClassRule(USkeletalMeshComponent::StaticClass(), TEXT("SK_"));
+	AddClassRule(UNiagaraSystem::StaticClass(), TEXT("NS_"));
+	AddClassRule(UNiagaraEmitter::StaticClass(), TEXT("NE_"));
+
+	// Default Epic naming of material instances
+	ClassRules[MaterialInstanceRule].StripPrefixes.Add(TEXT("M_"));
+	ClassRules[MaterialInstanceRule].StripSuffixes.Add(TEXT("_Inst"));
+}
+
+FString UUdemyCourseSettings::GetQuarantinePath() const
+{
+	FString Path = QuarantinePath.Path;
+	Path.RemoveFromEnd(TEXT("/"));
+
+	return Path.StartsWith(TEXT("/")) ? Path : FString(UdemyCourseSettings::DefaultQuarantinePath);
+}
@@ -0,0 +1,254 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "SlateWidgets/AdvancedDeletionWidget.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Drives SAdvancedDeletionTab against a synthetic asset set, records the time and allocations of every step
+ * and fails when the list stops behaving, e.g. when scrolling generates widgets for more than the visible rows.
+ * Run from the Session Frontend, or headless in CI:
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests UdemyCourse.AdvancedDeletion.Benchmark;Quit"
+ * Add -llm to also record the net bytes allocated per step.
+ * A friend of the tab, so it can call the same handlers as the buttons and menus do.
+ */
+class FAdvancedDeletionBenchmark
+{
+public:
+	static bool Run(int32 NumAssets, FAutomationTestBase& Test);
+
+private:
+	/** Number of list frames ticked while scrolling from the top to the bottom */
+	static constexpr int32 NumScrollFrames = 240;
+	/** A 720 pixel high list shows a few dozen rows, a virtualized list never generates much more than that */
+	static constexpr int32 MaxGeneratedRows = 256;
+	/** Scroll frames slower than this are reported as a warning, timings depend too much on the machine to fail on */
+	static constexpr double ScrollFrameBudgetMilliseconds = 33.0;
+
+	struct FStepStats
+	{
+		double Milliseconds = 0.0;
+		/** Calls into the allocator, only counted in builds with stats */
+		int64 NumMallocs = 0;
+		/** Net bytes allocated, only tracked while LLM is enabled */
+		int64 AllocatedBytes = 0;
+	};
+
+	template<typename StepType>
+	static FStepStats MeasureStep(FAutomationTestBase& Test, const TCHAR* StepName, StepType&& Step);
+
+	static uint64 GetNumMallocs();
+	static int64 GetTrackedBytes();
+	static TArray<TSharedPtr<FAssetData>> MakeSyntheticAssets(int32 NumAssets);
+	static void TickList(SAdvancedDeletionTab& Tab, const FGeometry& ListGeometry, double& InOutTime);
+};
+
+template<typename StepType>
+FAdvancedDeletionBenchmark::FStepStats FAdvancedDeletionBenchmark::MeasureStep(FAutomationTestBase& Test, const TCHAR* StepName, StepType&& Step)
+{
+	FStepStats Stats;
+	const uint64 StartMallocs = GetNumMallocs();
+	const int64 StartBytes = GetTrackedBytes();
+	const double StartTime = FPlatformTime::Seconds();
+
+	Step();
+
+	Stats.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	Stats.NumMallocs = static_cast<int64>(GetNumMallocs() - StartMallocs);
+	Stats.AllocatedBytes = GetTrackedBytes() - StartBytes;
+
+	Test.AddInfo(FString::Printf(TEXT("%-24s %10.2f ms %10lld mallocs %+10.2f MiB"), StepName, Stats.Milliseconds, Stats.NumMallocs, Stats.AllocatedBytes / (1024.0 * 1024.0)));
+	Test.AddAnalyticsItem(FString::Printf(TEXT("%s=%.3f"), StepName, Stats.Milliseconds));
+	return Stats;
+}
+
+uint64 FAdvancedDeletionBenchmark::GetNumMallocs()
+{
+#if STATS
+	return FMalloc::TotalMallocCalls;
+#else
+	return 0;
+#endif
+}
+
+int64 FAdvancedDeletionBenchmark::GetTrackedBytes()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (FLowLevelMemTracker::IsEnabled())
+	{
+		return FLowLevelMemTracker::Get().GetTotalTrackedMemory(ELLMTracker::Default);
+	}
+#endif
+
+	return 0;
+}
+
+TArray<TSharedPtr<FAssetData>> FAdvancedDeletionBenchmark::MakeSyntheticAssets(int32 NumAssets)
+{
+	// A few classes and folders, and names that repeat every so often so duplicate filters find groups
+	static const FTopLevelAssetPath ClassPaths[] =
+	{
+		FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("StaticMesh")),
+		FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Texture2D")),
+		FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Material")),
+		FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("MaterialInstanceConstant")),
+		FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("SoundWave")),
+	};
+
+	TArray<TSharedPtr<FAssetData>> Assets;
+	Assets.Reserve(NumAssets);
+
+	for (int32 Index = 0; Index < NumAssets; ++Index)
+	{
+		const FTopLevelAssetPath& ClassPath = ClassPaths[Index % UE_ARRAY_COUNT(ClassPaths)];
+		const FName PackagePath(*FString::Printf(TEXT("/Game/Benchmark/Folder%03d"), Index % 500));
+		const FName AssetName(*FString::Printf(TEXT("%s_Asset%d"), *ClassPath.GetAssetName().ToString(), Index % (NumAssets / 2 + 1)));
+		const FName PackageName(*FString::Printf(TEXT("%s/%s"), *PackagePath.ToString(), *AssetName.ToString()));
+
+		Assets.Add(MakeShared<FAssetData>(PackageName, PackagePath, AssetName, ClassPath));
+	}
+
+	return Assets;
+}
+
+void FAdvancedDeletionBenchmark::TickList(SAdvancedDeletionTab& Tab, const FGeometry& ListGeometry, double& InOutTime)
+{
+	// Ticking the list is where it regenerates the row widgets for the visible range
+	constexpr float DeltaTime = 1.f / 60.f;
+	InOutTime += DeltaTime;
+
+	Tab.SlatePrepass(1.f);
+	Tab.ConstructedList->Tick(ListGeometry, InOutTime, DeltaTime);
+}
+
+bool FAdvancedDeletionBenchmark::Run(int32 NumAssets, FAutomationTestBase& Test)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		Test.AddError(TEXT("The deletion tab benchmark needs Slate, run it in the editor (-nullrhi works)"));
+		return false;
+	}
+
+	Test.AddInfo(FString::Printf(TEXT("Advanced deletion tab benchmark, %d synthetic assets"), NumAssets));
+
+	TArray<TSharedPtr<FAssetData>> Assets;
+	TSharedPtr<SAdvancedDeletionTab> Tab;
+	const FGeometry ListGeometry = FGeometry::MakeRoot(FVector2D(1280.f, 720.f), FSlateLayoutTransform());
+	double CurrentTime = FPlatformTime::Seconds();
+
+	MeasureStep(Test, TEXT("Synthetic assets"), [&]() {Assets = MakeSyntheticAssets(NumAssets);});
+	MeasureStep(Test, TEXT("Construct"), [&]() {Tab = SNew(SAdvancedDeletionTab).AssetsDataToStore(Assets);});
+	MeasureStep(Test, TEXT("First frame"), [&]() {TickList(*Tab, ListGeometry, CurrentTime);});
+
+	Test.TestEqual(TEXT("Every asset is listed"), Tab->DisplayedAssetsData.Num(), NumAssets);
+
+	// Frame times while scrolling the whole list, so row regeneration shows up per frame
+	double MaxFrameMilliseconds = 0.0;
+	int32 MaxNumGeneratedRows = 0;
+	const FStepStats ScrollStats = MeasureStep(Test, TEXT("Scroll"), [&]()
+	{
+		const double ScrollStep = static_cast<double>(Tab->DisplayedAssetsData.Num()) / NumScrollFrames;
+
+		for (int32 Frame = 0; Frame < NumScrollFrames; ++Frame)
+		{
+			const double FrameStartTime = FPlatformTime::Seconds();
+			Tab->ConstructedList->SetScrollOffset(static_cast<float>(Frame * ScrollStep));
+			TickList(*Tab, ListGeometry, CurrentTime);
+			MaxFrameMilliseconds = FMath::Max(MaxFrameMilliseconds, (FPlatformTime::Seconds() - FrameStartTime) * 1000.0);
+			MaxNumGeneratedRows = FMath::Max(MaxNumGeneratedRows, Tab->ConstructedList->GetNumGeneratedChildren());
+		}
+	});
+
+	Test.AddInfo(FString::Printf(TEXT("%-24s %10.2f ms avg %10.2f ms max %10lld mallocs avg"), TEXT("Scroll frame"), ScrollStats.Milliseconds / NumScrollFrames, MaxFrameMilliseconds, ScrollStats.NumMallocs / NumScrollFrames));
+	Test.AddAnalyticsItem(FString::Printf(TEXT("ScrollFrameMax=%.3f"), MaxFrameMilliseconds));
+	Test.TestTrue(FString::Printf(TEXT("Scrolling generates at most %d row widgets (generated %d)"), MaxGeneratedRows, MaxNumGeneratedRows), MaxNumGeneratedRows <= MaxGeneratedRows);
+
+	if (MaxFrameMilliseconds > ScrollFrameBudgetMilliseconds)
+	{
+		Test.AddWarning(FString::Printf(TEXT("Slowest scroll frame took %.2f ms, the budget is %.2f ms"), MaxFrameMilliseconds, ScrollFrameBudgetMilliseconds));
+	}
+
+	MeasureStep(Test, TEXT("Search"), [&]()
+	{
+		Tab->SearchText = TEXT("asset1");
+		Tab->SearchIndex.Query(Tab->SearchText, Tab->SearchMatches);
+		Tab->UpdateDisplayedRows();
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	Test.TestTrue(TEXT("Search narrows the list down"), Tab->DisplayedAssetsData.Num() > 0 && Tab->DisplayedAssetsData.Num() < NumAssets);
+
+	MeasureStep(Test, TEXT("Clear search"), [&]()
+	{
+		Tab->SearchText.Reset();
+		Tab->SearchIndex.Query(Tab->SearchText, Tab->SearchMatches);
+		Tab->UpdateDisplayedRows();
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	Test.TestEqual(TEXT("Clearing the search lists every asset again"), Tab->DisplayedAssetsData.Num(), NumAssets);
+
+	MeasureStep(Test, TEXT("Filter duplicate names"), [&]()
+	{
+		Tab->ToggleFilter(Tab->FilterPipeline.DuplicateNameFilter);
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	MeasureStep(Test, TEXT("Filter off"), [&]()
+	{
+		Tab->ToggleFilter(Tab->FilterPipeline.DuplicateNameFilter);
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	Test.TestEqual(TEXT("Disabling the filter lists every asset again"), Tab->DisplayedAssetsData.Num(), NumAssets);
+
+	MeasureStep(Test, TEXT("Select all"), [&]() {Tab->OnSelectAllButtonClicked();});
+	Test.TestEqual(TEXT("Select all checks every listed asset"), Tab->StoredAssetsDataToDelete.Num(), NumAssets);
+
+	MeasureStep(Test, TEXT("Deselect all"), [&]() {Tab->OnDeselectAllButtonClicked();});
+	Test.TestEqual(TEXT("Deselect all clears every check"), Tab->StoredAssetsDataToDelete.Num(), 0);
+
+	MeasureStep(Test, TEXT("Sort by name"), [&]()
+	{
+		Tab->OnColumnSortModeChanged(EColumnSortPriority::Primary, FName(TEXT("Name")), EColumnSortMode::Ascending);
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	MeasureStep(Test, TEXT("Sort by size"), [&]()
+	{
+		Tab->OnColumnSortModeChanged(EColumnSortPriority::Primary, FName(TEXT("DiskSize")), EColumnSortMode::Descending);
+		TickList(*Tab, ListGeometry, CurrentTime);
+	});
+
+	Test.TestEqual(TEXT("Sorting keeps every asset listed"), Tab->DisplayedAssetsData.Num(), NumAssets);
+
+	MeasureStep(Test, TEXT("Destroy"), [&]()
+	{
+		Tab.Reset();
+		Assets.Empty();
+	});
+
+	return !Test.HasAnyErrors();
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAdvancedDeletionBenchmarkTest, "UdemyCourse.AdvancedDeletion.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FAdvancedDeletionBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(TEXT("10k"));
+	OutTestCommands.Add(TEXT("10000"));
+	OutBeautifiedNames.Add(TEXT("100k"));
+	OutTestCommands.Add(TEXT("100000"));
+	OutBeautifiedNames.Add(TEXT("500k"));
+	OutTestCommands.Add(TEXT("500000"));
+}
+
+bool FAdvancedDeletionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	return FAdvancedDeletionBenchmark::Run(FCString::Atoi(*Parameters), *this);
+}
+
+#endif
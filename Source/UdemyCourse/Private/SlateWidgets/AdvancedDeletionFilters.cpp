@@ -0,0 +1,429 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "SlateWidgets/AdvancedDeletionFilters.h"
+#include "UdemyCourse.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedDeletionFilters"
+
+#pragma region DeletionListFilter
+
+const TBitArray<>& FDeletionListFilter::Evaluate(const TArray<FDeletionListRowPtr>& Rows, int32 NumRowIds)
+{
+	// New rows always get a higher RowId, so a grown id range means rows were added
+	if (bDirty || IsOutdated() || (DependsOnRowSet() && Passes.Num() != NumRowIds))
+	{
+		Passes.Init(false, NumRowIds);
+		EvaluateRowSet(Rows, Passes);
+		bDirty = false;
+	}
+	else if (Passes.Num() < NumRowIds)
+	{
+		// Only evaluate the rows added since the last evaluation, the memoized bits of the others still hold
+		const int32 FirstNewRowId = Passes.Num();
+		Passes.Add(false, NumRowIds - FirstNewRowId);
+
+		for (const FDeletionListRowPtr& Row : Rows)
+		{
+			if (Row->RowId >= FirstNewRowId)
+			{
+				Passes[Row->RowId] = PassesFilter(*Row);
+			}
+		}
+	}
+
+	return Passes;
+}
+
+void FDeletionListFilter::EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const
+{
+	for (const FDeletionListRowPtr& Row : Rows)
+	{
+		OutPasses[Row->RowId] = PassesFilter(*Row);
+	}
+}
+
+#pragma endregion
+
+#pragma region ClassFilter
+
+FText FDeletionListClassFilter::GetDisplayName() const
+{
+	return LOCTEXT("ClassFilter", "Class");
+}
+
+void FDeletionListClassFilter::ToggleClass(FName ClassName)
+{
+	if (AllowedClasses.Remove(ClassName) == 0)
+	{
+		AllowedClasses.Add(ClassName);
+	}
+
+	// The filter is only meaningful while at least one class is picked
+	SetEnabled(!AllowedClasses.IsEmpty());
+	MarkDirty();
+}
+
+bool FDeletionListClassFilter::PassesFilter(FDeletionListRow& Row) const
+{
+	return AllowedClasses.Contains(Row.GetClassName());
+}
+
+#pragma endregion
+
+#pragma region PathFilter
+
+FText FDeletionListPathFilter::GetDisplayName() const
+{
+	return LOCTEXT("PathFilter", "Sub-path");
+}
+
+void FDeletionListPathFilter::SetSubPath(const FString& InSubPath)
+{
+	SubPath = InSubPath.TrimStartAndEnd();
+	SetEnabled(!SubPath.IsEmpty());
+	MarkDirty();
+}
+
+bool FDeletionListPathFilter::PassesFilter(FDeletionListRow& Row) const
+{
+	// Contains() instead of StartsWith(), so typing the folder name alone is enough
+	return Row.AssetData->PackagePath.ToString().Contains(SubPath);
+}
+
+#pragma endregion
+
+#pragma region UnusedFilter
+
+FText FDeletionListUnusedFilter::GetDisplayName() const
+{
+	return LOCTEXT("UnusedFilter", "Unused Assets");
+}
+
+bool FDeletionListUnusedFilter::PassesFilter(FDeletionListRow& Row) const
+{
+	return Row.ReferencerCount == 0;
+}
+
+#pragma endregion
+
+#pragma region DuplicateNameFilter
+
+FText FDeletionListDuplicateNameFilter::GetDisplayName() const
+{
+	return LOCTEXT("DuplicateNameFilter", "Duplicate Names");
+}
+
+void FDeletionListDuplicateNameFilter::EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const
+{
+	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+	TArray<FDeletionListRowPtr> DuplicateNameRows;
+	UdemyCourseModule.GetDuplicateNameAssets(Rows, DuplicateNameRows);
+
+	for (const FDeletionListRowPtr& Row : DuplicateNameRows)
+	{
+		OutPasses[Row->RowId] = true;
+	}
+}
+
+void FDeletionListDuplicateNameFilter::GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const
+{
+	for (TArray<FDeletionListRowPtr>& Group : GroupDuplicateRows(FilteredRows, [](const FDeletionListRow& Row) {return Row.AssetData->AssetName;}))
+	{
+		const FText Label = FText::FromName(Group[0]->AssetData->AssetName);
+		OutGroupHeaders.Add(FDeletionListRow::MakeGroupHeader(Label, MoveTemp(Group)));
+	}
+}
+
+#pragma endregion
+
+#pragma region DuplicateContentFilter
+
+FText FDeletionListDuplicateContentFilter::GetDisplayName() const
+{
+	return LOCTEXT("DuplicateContentFilter", "Duplicate Content");
+}
+
+void FDeletionListDuplicateContentFilter::EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const
+{
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(Rows.Num());
+
+	for (const FDeletionListRowPtr& Row : Rows)
+	{
+		PackageNames.Add(Row->AssetData->PackageName);
+	}
+
+	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+	const TArray<FAssetContentHash> Hashes = UdemyCourseModule.GetContentHashCache().GetHashes(PackageNames, &bHashPassCancelled);
+
+	// Identical bytes of different classes are a coincidence, not a duplicate
+	typedef TPair<FName, FAssetContentHash> FContentKey;
+	TMap<FContentKey, int32> NumRowsPerKey;
+	NumRowsPerKey.Reserve(Rows.Num());
+	RowHashes.Reset();
+
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		if (Hashes[Index].IsValid())
+		{
+			++NumRowsPerKey.FindOrAdd(FContentKey(Rows[Index]->GetClassName(), Hashes[Index]));
+			RowHashes.Add(Rows[Index]->RowId, Hashes[Index]);
+		}
+	}
+
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		if (Hashes[Index].IsValid())
+		{
+			OutPasses[Rows[Index]->RowId] = NumRowsPerKey.FindChecked(FContentKey(Rows[Index]->GetClassName(), Hashes[Index])) > 1;
+		}
+	}
+}
+
+void FDeletionListDuplicateContentFilter::GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const
+{
+	// Filtered rows passed this filter, so each of them has a hash from the last evaluation
+	auto GetContentKey = [this](const FDeletionListRow& Row)
+	{
+		return TPair<FName, FAssetContentHash>(Row.GetClassName(), RowHashes.FindRef(Row.RowId));
+	};
+
+	for (TArray<FDeletionListRowPtr>& Group : GroupDuplicateRows(FilteredRows, GetContentKey))
+	{
+		const FText Label = FText::Format(
+			LOCTEXT("DuplicateContentGroup", "{0} {1}"),
+			FText::FromName(Group[0]->GetClassName()),
+			FText::FromString(FString::Printf(TEXT("%016llx"), RowHashes.FindRef(Group[0]->RowId).High))
+		);
+		OutGroupHeaders.Add(FDeletionListRow::MakeGroupHeader(Label, MoveTemp(Group)));
+	}
+}
+
+#pragma endregion
+
+#pragma region NearDuplicateTextureFilter
+
+FText FDeletionListNearDuplicateTextureFilter::GetDisplayName() const
+{
+	return LOCTEXT("NearDuplicateTextureFilter", "Similar Textures");
+}
+
+void FDeletionListNearDuplicateTextureFilter::EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const
+{
+	TArray<FAssetData> Assets;
+	Assets.Reserve(Rows.Num());
+
+	for (const FDeletionListRowPtr& Row : Rows)
+	{
+		Assets.Add(*Row->AssetData);
+	}
+
+	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+	const TArray<TOptional<uint64>> Hashes = UdemyCourseModule.GetTextureHashCache().GetHashes(Assets, &bHashPassCancelled);
+
+	// Only textures with a hash take part in the clustering
+	TArray<int32> HashedRowIds;
+	TArray<uint64> RowHashes;
+
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		if (Hashes[Index].IsSet())
+		{
+			HashedRowIds.Add(Rows[Index]->RowId);
+			RowHashes.Add(Hashes[Index].GetValue());
+		}
+	}
+
+	TArray<int32> ClusterIds;
+	FTexturePerceptualHashCache::FindClusters(RowHashes, ClusterIds);
+	RowClusterIds.Reset();
+
+	for (int32 Index = 0; Index < HashedRowIds.Num(); ++Index)
+	{
+		if (ClusterIds[Index] != INDEX_NONE)
+		{
+			OutPasses[HashedRowIds[Index]] = true;
+			RowClusterIds.Add(HashedRowIds[Index], ClusterIds[Index]);
+		}
+	}
+}
+
+void FDeletionListNearDuplicateTextureFilter::GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const
+{
+	auto GetClusterId = [this](const FDeletionListRow& Row) {return RowClusterIds.FindRef(Row.RowId);};
+
+	for (TArray<FDeletionListRowPtr>& Group : GroupDuplicateRows(FilteredRows, GetClusterId))
+	{
+		const FText Label = FText::Format(LOCTEXT("NearDuplicateTextureGroup", "Similar to {0}"), FText::FromName(Group[0]->AssetData->AssetName));
+		OutGroupHeaders.Add(FDeletionListRow::MakeGroupHeader(Label, MoveTemp(Group)));
+	}
+}
+
+#pragma endregion
+
+#pragma region SizeFilter
+
+FText FDeletionListSizeFilter::GetDisplayName() const
+{
+	return LOCTEXT("SizeFilter", "Disk Size");
+}
+
+void FDeletionListSizeFilter::SetSizeRangeKB(TOptional<int32> InMinSizeKB, TOptional<int32> InMaxSizeKB)
+{
+	MinSizeKB = InMinSizeKB;
+	MaxSizeKB = InMaxSizeKB;
+	SetEnabled(MinSizeKB.IsSet() || MaxSizeKB.IsSet());
+	MarkDirty();
+}
+
+bool FDeletionListSizeFilter::PassesFilter(FDeletionListRow& Row) const
+{
+	// Packages without registry package data have no known size, so they can't be in any range
+	if (Row.DiskSize < 0)
+	{
+		return false;
+	}
+
+	const int64 SizeKB = Row.DiskSize / 1024;
+
+	return (!MinSizeKB.IsSet() || SizeKB >= MinSizeKB.GetValue()) && (!MaxSizeKB.IsSet() || SizeKB <= MaxSizeKB.GetValue());
+}
+
+#pragma endregion
+
+#pragma region ModifiedFilter
+
+FText FDeletionListModifiedFilter::GetDisplayName() const
+{
+	return LOCTEXT("ModifiedFilter", "Not Modified Recently");
+}
+
+void FDeletionListModifiedFilter::SetMinDaysUnmodified(int32 InMinDaysUnmodified)
+{
+	MinDaysUnmodified = FMath::Max(0, InMinDaysUnmodified);
+	MarkDirty();
+}
+
+bool FDeletionListModifiedFilter::IsOutdated() const
+{
+	return FDateTime::UtcNow().GetDate() != ReferenceDate;
+}
+
+bool FDeletionListModifiedFilter::PassesFilter(FDeletionListRow& Row) const
+{
+	const FDateTime& FileTimestamp = Row.GetFileTimestamp();
+
+	if (FileTimestamp == FDateTime::MinValue())
+	{
+		return false;
+	}
+
+	// Whole days only, so the result can't change before the date does
+	return (ReferenceDate - FileTimestamp.GetDate()).GetDays() >= MinDaysUnmodified;
+}
+
+void FDeletionListModifiedFilter::EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const
+{
+	ReferenceDate = FDateTime::UtcNow().GetDate();
+	FDeletionListFilter::EvaluateRowSet(Rows, OutPasses);
+}
+
+#pragma endregion
+
+#pragma region FilterPipeline
+
+FDeletionListFilterPipeline::FDeletionListFilterPipeline()
+	: ClassFilter(MakeShared<FDeletionListClassFilter>())
+	, PathFilter(MakeShared<FDeletionListPathFilter>())
+	, UnusedFilter(MakeShared<FDeletionListUnusedFilter>())
+	, DuplicateNameFilter(MakeShared<FDeletionListDuplicateNameFilter>())
+	, DuplicateContentFilter(MakeShared<FDeletionListDuplicateContentFilter>())
+	, NearDuplicateTextureFilter(MakeShared<FDeletionListNearDuplicateTextureFilter>())
+	, SizeFilter(MakeShared<FDeletionListSizeFilter>())
+	, ModifiedFilter(MakeShared<FDeletionListModifiedFilter>())
+{
+	// Cheapest filters first. The order doesn't change the result, only how the filters are listed
+	Filters.Add(ClassFilter);
+	Filters.Add(PathFilter);
+	Filters.Add(UnusedFilter);
+	Filters.Add(SizeFilter);
+	Filters.Add(DuplicateNameFilter);
+	Filters.Add(ModifiedFilter);
+	Filters.Add(DuplicateContentFilter);
+	Filters.Add(NearDuplicateTextureFilter);
+}
+
+int32 FDeletionListFilterPipeline::GetNumEnabledFilters() const
+{
+	int32 NumEnabledFilters = 0;
+
+	for (const TSharedRef<FDeletionListFilter>& Filter : Filters)
+	{
+		NumEnabledFilters += Filter->IsEnabled() ? 1 : 0;
+	}
+
+	return NumEnabledFilters;
+}
+
+void FDeletionListFilterPipeline::OnRowsRemoved()
+{
+	for (const TSharedRef<FDeletionListFilter>& Filter : Filters)
+	{
+		if (Filter->DependsOnRowSet())
+		{
+			Filter->MarkDirty();
+		}
+	}
+}
+
+void FDeletionListFilterPipeline::OnPackagesChanged()
+{
+	for (const TSharedRef<FDeletionListFilter>& Filter : Filters)
+	{
+		if (Filter->DependsOnPackageContent())
+		{
+			Filter->MarkDirty();
+		}
+	}
+}
+
+const FDeletionListFilter* FDeletionListFilterPipeline::GetGroupingFilter() const
+{
+	for (const TSharedRef<FDeletionListFilter>& Filter : Filters)
+	{
+		if (Filter->IsEnabled() && Filter->CanGroupRows())
+		{
+			return &Filter.Get();
+		}
+	}
+
+	return nullptr;
+}
+
+void FDeletionListFilterPipeline::Apply(const TArray<FDeletionListRowPtr>& InRows, int32 NumRowIds, TArray<FDeletionListRowPtr>& OutFilteredRows)
+{
+	TBitArray<> CombinedPasses(true, NumRowIds);
+
+	// Disabled filters are never evaluated, enabled ones return their memoized bits unless dirty
+	for (const TSharedRef<FDeletionListFilter>& Filter : Filters)
+	{
+		if (Filter->IsEnabled())
+		{
+			CombinedPasses.CombineWithBitwiseAND(Filter->Evaluate(InRows, NumRowIds), EBitwiseOperatorFlags::MaintainSize);
+		}
+	}
+
+	OutFilteredRows.Reset(InRows.Num());
+
+	for (const FDeletionListRowPtr& Row : InRows)
+	{
+		if (CombinedPasses[Row->RowId])
+		{
+			OutFilteredRows.Add(Row);
+		}
+	}
+}
+
+#pragma endregion
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,101 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "UObject/UnrealNames.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	/** Sorts the unique keys lexically and writes each key's position back into the rank member of every row */
+	template<typename KeyGetterType>
+	void RankUniqueNames(const TArray<FDeletionListRowPtr>& Rows, KeyGetterType GetKey, int32 FDeletionListRow::* RankMember)
+	{
+		TSet<FName> UniqueNames;
+
+		for (const FDeletionListRowPtr& Row : Rows)
+		{
+			UniqueNames.Add(GetKey(*Row));
+		}
+
+		TArray<FName> SortedNames = UniqueNames.Array();
+		SortedNames.Sort(FNameLexicalLess());
+
+		TMap<FName, int32> NameRanks;
+		NameRanks.Reserve(SortedNames.Num());
+
+		for (int32 Index = 0; Index < SortedNames.Num(); ++Index)
+		{
+			NameRanks.Add(SortedNames[Index], Index);
+		}
+
+		for (const FDeletionListRowPtr& Row : Rows)
+		{
+			(*Row).*RankMember = NameRanks.FindChecked(GetKey(*Row));
+		}
+	}
+}
+
+FDeletionListRowPtr FDeletionListRow::Make(const TSharedPtr<FAssetData>& InAssetData, IAssetRegistry& AssetRegistry)
+{
+	FDeletionListRowPtr Row = MakeShared<FDeletionListRow>();
+	Row->AssetData = InAssetData;
+
+	if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(InAssetData->PackageName))
+	{
+		Row->DiskSize = PackageData->DiskSize;
+	}
+
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(InAssetData->PackageName, Referencers);
+	Row->ReferencerCount = Referencers.Num();
+
+	return Row;
+}
+
+const FDateTime& FDeletionListRow::GetFileTimestamp()
+{
+	if (!FileTimestamp.IsSet())
+	{
+		FString PackageFilename;
+		FileTimestamp = FPackageName::DoesPackageExist(AssetData->PackageName.ToString(), &PackageFilename)
+			? IFileManager::Get().GetTimeStamp(*PackageFilename)
+			: FDateTime::MinValue();
+	}
+
+	return FileTimestamp.GetValue();
+}
+
+FDeletionListRowPtr FDeletionListRow::MakeGroupHeader(const FText& InLabel, TArray<FDeletionListRowPtr>&& InChildren)
+{
+	FDeletionListRowPtr Header = MakeShared<FDeletionListRow>();
+	Header->GroupLabel = FText::Format(INVTEXT("{0} ({1})"), InLabel, InChildren.Num());
+	Header->GroupChildren = MoveTemp(InChildren);
+
+	return Header;
+}
+
+const FDeletionListRow::FDisplayTexts& FDeletionListRow::GetDisplayTexts()
+{
+	if (!DisplayTexts.IsSet())
+	{
+		// The class comes from the class path of the asset data, resolving the UClass could load it
+		DisplayTexts = FDisplayTexts{
+			FText::FromName(GetClassName()),
+			FText::FromName(AssetData->AssetName),
+			FText::FromName(AssetData->PackagePath),
+			DiskSize >= 0 ? FText::AsMemory(DiskSize) : FText::FromString(TEXT("-")),
+			FText::AsNumber(ReferencerCount)
+		};
+	}
+
+	return DisplayTexts.GetValue();
+}
+
+void FDeletionListRow::BuildSortRanks(const TArray<FDeletionListRowPtr>& Rows)
+{
+	RankUniqueNames(Rows, [](const FDeletionListRow& Row) {return Row.GetClassName();}, &FDeletionListRow::ClassRank);
+	RankUniqueNames(Rows, [](const FDeletionListRow& Row) {return Row.AssetData->AssetName;}, &FDeletionListRow::NameRank);
+	RankUniqueNames(Rows, [](const FDeletionListRow& Row) {return Row.AssetData->PackagePath;}, &FDeletionListRow::PathRank);
+}
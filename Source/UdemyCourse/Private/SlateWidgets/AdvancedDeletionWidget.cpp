@@ -4,14 +4,58 @@
 #include "Internationalization/Text.h" // This may not be required if already included in a core dependency header/module
 #include "DebugHeader.h"
 #include "UdemyCourse.h"
-
-// Custom macros for combo box entries
-#define LISTALL LOCTEXT("ComboBoxPtr", "All Assets")
-#define LISTUNUSED LOCTEXT("ComboBoxPtr", "Unused Assets")
-#define LISTDUPLICATES LOCTEXT("ComboBoxPtr", "Duplicate Names")
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Algo/Sort.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "AssetThumbnail.h"
+#include "Widgets/Views/STreeView.h"
+#include "Widgets/Views/SExpanderArrow.h"
+#include "ProcessData/DeletionListExporter.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
+#include "ProcessData/AssetQuarantine.h"
+#include "Settings/UdemyCourseSettings.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedDeletionWidget"
 
+namespace AdvancedDeletionColumns
+{
+	static const FName CheckBox(TEXT("CheckBox"));
+	static const FName Thumbnail(TEXT("Thumbnail"));
+	static const FName Class(TEXT("Class"));
+	static const FName Name(TEXT("Name"));
+	static const FName Path(TEXT("Path"));
+	static const FName DiskSize(TEXT("DiskSize"));
+	static const FName Referencers(TEXT("Referencers"));
+	static const FName Delete(TEXT("Delete"));
+}
+
+void SAdvancedDeletionListRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
+{
+	RowData = InArgs._RowData;
+	OnGenerateCell = InArgs._OnGenerateCell;
+
+	SMultiColumnTableRow<FDeletionListRowPtr>::Construct(FSuperRowType::FArguments(), InOwnerTable);
+}
+
+TSharedRef<SWidget> SAdvancedDeletionListRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	if (!OnGenerateCell.IsBound())
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	return OnGenerateCell.Execute(RowData, ColumnName);
+}
+
 // Minimal constructor for memory object allocation of TSharedPtrs
 SAdvancedDeletionTab::SAdvancedDeletionTab()
 // Initialize the empty memory object
@@ -20,24 +64,63 @@ SAdvancedDeletionTab::SAdvancedDeletionTab()
 
 }
 
+SAdvancedDeletionTab::~SAdvancedDeletionTab()
+{
+	// The registry may already be gone when the editor shuts down with the tab open
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+}
+
 void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 
 	// Global variable in the header, and ASsetsDataToStore is the SLATE_ARGUMENT()
 	// See FUdemyCourseModule::OnSpawnAdvancedDeletionTab and FUdemyCourseModule::GetAssetDataInDirectory
-	StoredAssetsData = InArgs._AssetsDataToStore; // Get assets to add to list view
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	StoredAssetsData.Empty(InArgs._AssetsDataToStore.Num());
+	RowsByObjectPath.Empty(InArgs._AssetsDataToStore.Num());
+	WatchedPath = InArgs._WatchedPath;
+
+	// Get assets to add to list view. Sort keys are cached here, once per row
+	for (const TSharedPtr<FAssetData>& AssetData : InArgs._AssetsDataToStore)
+	{
+		if (AssetData.IsValid())
+		{
+			FDeletionListRowPtr Row = FDeletionListRow::Make(AssetData, AssetRegistry);
+			Row->RowId = NextRowId++;
+			StoredAssetsData.Add(Row);
+			RowsByObjectPath.Add(AssetData->GetSoftObjectPath(), Row);
+		}
+	}
+
+	FDeletionListRow::BuildSortRanks(StoredAssetsData);
+	// Built once here, so typing into the search box never has to scan every asset name
+	SearchIndex.Build(StoredAssetsData);
+	SearchMatches.Init(true, NextRowId);
+	FilteredAssetsData = StoredAssetsData;
 	DisplayedAssetsData = StoredAssetsData;
 
 	// Clear memory for global reference/pointer arrays
-	ConstructedCheckBoxes.Empty();
 	StoredAssetsDataToDelete.Empty();
-	ComboBoxSourceItems.Empty();
 
-	// Add a first element to the combo box
-	ComboBoxSourceItems.Add(MakeShared<FText>(LISTALL));
-	ComboBoxSourceItems.Add(MakeShared<FText>(LISTUNUSED));
-	ComboBoxSourceItems.Add(MakeShared<FText>(LISTDUPLICATES));
+	// Keep the list in sync with imports, renames and deletes made elsewhere in the editor
+	if (!WatchedPath.IsEmpty())
+	{
+		AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSP(this, &SAdvancedDeletionTab::OnRegistryAssetAdded);
+		AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddSP(this, &SAdvancedDeletionTab::OnRegistryAssetRemoved);
+		AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddSP(this, &SAdvancedDeletionTab::OnRegistryAssetRenamed);
+		AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddSP(this, &SAdvancedDeletionTab::OnRegistryAssetUpdated);
+		PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddSP(this, &SAdvancedDeletionTab::OnPackageSaved);
+	}
 
 	FSlateFontInfo TitleTextFont = GetEmbossedTextFont();
 	TitleTextFont.Size = 12.f;
@@ -80,36 +163,38 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 			+ SHorizontalBox::Slot()
 			.AutoWidth()
 			[
-				ConstructComboBox()
+				ConstructFilterComboButton()
 			]
-		]
-
-		// TODO: Add a heading row with same number of columns as the list 
-		// (likely need to explicitly-define the first list entry in OnGenerateRowForList()
-		+SVerticalBox::Slot()
-		.AutoHeight()
-		.Padding(0.f, 10.f, 0.f, 10.f)
-		[
-			SNew(SHorizontalBox)
 			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			.Padding(6.f, 0.f, 0.f, 0.f)
 			[
-				SNew(STextBlock)
-				.Text(LOCTEXT("ColumnTitles", "TODO: Add column titles entry as a first row for Select/Asset Class/Asset Name"))
-				.Justification(ETextJustify::Center)
+				ConstructSearchBox()
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(6.f, 0.f, 0.f, 0.f)
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SAdvancedDeletionTab::GetShowThumbnailsState)
+				.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnShowThumbnailsChanged)
+				.ToolTipText(LOCTEXT("ShowThumbnailsTooltip", "Adds a thumbnail column to the list. Thumbnails are only rendered for visible rows."))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ShowThumbnails", "Thumbnails"))
+				]
 			]
 		]
 
 		// Third slot is for the list
+		// The list view scrolls by itself. Giving it a bounded height keeps it virtualized, so only visible rows get widgets
 		+SVerticalBox::Slot()
-		.VAlign(VAlign_Fill) // VAlign_Fill scroll box scrollable
+		.FillHeight(1.f)
+		.Padding(0.f, 10.f)
 		[
-			SNew(SScrollBox)
-			//.AllowOverscroll(EAllowOverscroll::Yes) // Doesn't enable interia scrolling, and is already default yes
-			+SScrollBox::Slot()
-			.Padding(0.f, 10.f)
-			[
-				ConstructList()
-			]
+			ConstructList()
 		]
 
 		// Fourth slot for three buttons: to populate the list and refresh results
@@ -151,117 +236,144 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 				//.ToolTipText(LOCTEXT("DeleteSelectedTooltip", "Deletes all assets in the current list."))
 				//.OnClicked(this, &SAdvancedDeletionTab::OnDeleteSelectedbuttonClicked)
 			]
+			+SHorizontalBox::Slot()
+			[
+				ConstructExportButton()
+			]
 		]
 	];
 }
 
-TSharedRef<ITableRow> SAdvancedDeletionTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SAdvancedDeletionTab::OnGenerateRowForList(FDeletionListRowPtr RowToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	if (RowToDisplay.IsValid() && RowToDisplay->IsGroupHeader())
+	{
+		return ConstructGroupHeaderRow(RowToDisplay, OwnerTable);
+	}
+
 	// Additional safety check to ensure the asset data is valid
-	if (!AssetDataToDisplay->IsValid())
+	if (!RowToDisplay.IsValid() || !RowToDisplay->AssetData->IsValid())
 	{
 		// Return an empty row widget for invalid asset data
-		return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable);
+		return SNew(STableRow<FDeletionListRowPtr>, OwnerTable);
 	}
 
-	const FString DisplayAssetName = AssetDataToDisplay->AssetName.ToString();
-	const FString DisplayAssetClass = AssetDataToDisplay->GetClass()->GetName();// AssetDataToDisplay->AssetClassPath.ToString();
-	FSlateFontInfo AssetClassFont = GetEmbossedTextFont();
-	AssetClassFont.Size = 10.f;
+	// Each column of the header row asks OnGenerateCellForList() for its widget
+	return SNew(SAdvancedDeletionListRow, OwnerTable)
+		.RowData(RowToDisplay)
+		.OnGenerateCell(this, &SAdvancedDeletionTab::OnGenerateCellForList);
+}
 
-	// Construct rows of the table. The row defaults to one slot
-	TSharedRef<STableRow<TSharedPtr<FAssetData>>> ListViewRowWidget = SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable)
-		// Vertical gap between generated rows
-		//.Padding(FMargin(0.f, 5.f, 0.f, 5.f))
-		[
-			SNew(SHorizontalBox)
-			// First slot: Check box for asset selection
-			+SHorizontalBox::Slot()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Center)
-			.AutoWidth()
-			.Padding(0.f, 0.f, 3.f, 0.f)
-			//.FillWidth(.03f) // Gap between checkbox and asset name
-			[
-				ConstructCheckBox(AssetDataToDisplay)
-			]
+TSharedRef<ITableRow> SAdvancedDeletionTab::ConstructGroupHeaderRow(const FDeletionListRowPtr& GroupHeader, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	// A plain table row spans every column, so the label isn't squeezed into the first one
+	TSharedRef<STableRow<FDeletionListRowPtr>> ConstructedRow = SNew(STableRow<FDeletionListRowPtr>, OwnerTable);
 
-			//// Space between slots
-			//+SHorizontalBox::Slot()
-			//[
-			//	SNew(SSpacer)
-			//	.Size(FVector2D(5.f, 0.f))
-			//]
+	FSlateFontInfo GroupFont = GetEmbossedTextFont();
+	GroupFont.Size = 10.f;
 
-			// Second slot: Display asset class name
-			+SHorizontalBox::Slot()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Center)
-			.AutoWidth()
-			.Padding(0.f, 0.f, 6.f, 0.f)
-			//.FillWidth(0.2f) // Truncates the text
-			[
-				ConstructRowText(FText::Format(LOCTEXT("AssetClass", "{0} |"), FText::FromString(DisplayAssetClass)), AssetClassFont)
-			]
+	ConstructedRow->SetContent(
+		SNew(SHorizontalBox)
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SExpanderArrow, ConstructedRow)
+		]
+		+SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(GroupHeader->GroupLabel)
+			.Font(GroupFont)
+		]
+	);
 
-			//// Spacer between slots
-			//+SHorizontalBox::Slot()
-			//[
-			//	SNew(SSpacer)
-			//	.Size(FVector2D(5.f, 0.f))
-			//]
+	return ConstructedRow;
+}
 
-			// Third slot: Display asset name
-			+SHorizontalBox::Slot()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Center)
-			.AutoWidth()
-			//.FillWidth(1.f)
-			[
-				SNew(STextBlock)
-				.Text(FText::Format(LOCTEXT("AssetName", "{0}"), FText::FromString(DisplayAssetName)))
-			]
+void SAdvancedDeletionTab::OnGetChildrenForList(FDeletionListRowPtr Row, TArray<FDeletionListRowPtr>& OutChildren)
+{
+	OutChildren = Row->GroupChildren;
+}
 
-			// Fourth slot: Inline button to delete the asset directly
-			+SHorizontalBox::Slot()
-			.HAlign(HAlign_Right)
-			[
-				ConstructButtonForRow(AssetDataToDisplay)
-			]
-		];
+TSharedRef<SWidget> SAdvancedDeletionTab::OnGenerateCellForList(FDeletionListRowPtr RowToDisplay, const FName& ColumnName)
+{
+	// Texts are cached on the row, so regenerating a row that scrolls back into view doesn't format them again
+	const FDeletionListRow::FDisplayTexts& DisplayTexts = RowToDisplay->GetDisplayTexts();
 
-		return ListViewRowWidget;
+	if (ColumnName == AdvancedDeletionColumns::CheckBox)
+	{
+		return ConstructCheckBox(RowToDisplay);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Thumbnail)
+	{
+		return ConstructThumbnail(RowToDisplay);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Class)
+	{
+		FSlateFontInfo AssetClassFont = GetEmbossedTextFont();
+		AssetClassFont.Size = 10.f;
+		return ConstructRowText(DisplayTexts.Class, AssetClassFont);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Name)
+	{
+		return SNew(STextBlock)
+			.Text(DisplayTexts.Name);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Path)
+	{
+		return SNew(STextBlock)
+			.Text(DisplayTexts.Path);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::DiskSize)
+	{
+		return SNew(STextBlock)
+			.Text(DisplayTexts.DiskSize);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Referencers)
+	{
+		return SNew(STextBlock)
+			.Text(DisplayTexts.Referencers);
+	}
+	else if (ColumnName == AdvancedDeletionColumns::Delete)
+	{
+		// Inline button to delete the asset directly
+		return ConstructButtonForRow(RowToDisplay);
+	}
+
+	return SNullWidget::NullWidget;
 }
 
-TSharedRef<SCheckBox> SAdvancedDeletionTab::ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+TSharedRef<SCheckBox> SAdvancedDeletionTab::ConstructCheckBox(const FDeletionListRowPtr& RowToDisplay)
 {
 	TSharedRef<SCheckBox> ConstructedCheckBox = SNew(SCheckBox)
 		.Type(ESlateCheckBoxType::CheckBox)
-		.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnCheckBoxStateChanged, AssetDataToDisplay)
+		// Bound to the row, so select all works on rows without a widget and regenerated rows keep their state
+		.IsChecked(this, &SAdvancedDeletionTab::GetRowCheckState, RowToDisplay)
+		.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnCheckBoxStateChanged, RowToDisplay)
 		.Visibility(EVisibility::Visible);
 
-	// Add to array for select all button
-	ConstructedCheckBoxes.Add(ConstructedCheckBox);
 	return ConstructedCheckBox;
 }
 
-void SAdvancedDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData)
+void SAdvancedDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, FDeletionListRowPtr Row)
 {
 	switch (NewState)
 	{
 	case ECheckBoxState::Unchecked:
-		if (StoredAssetsDataToDelete.Contains(AssetData))
-		{
-			StoredAssetsDataToDelete.Remove(AssetData);
-		}
+		Row->bIsChecked = false;
+		StoredAssetsDataToDelete.Remove(Row);
 		break;
 
 	case ECheckBoxState::Checked:
-		StoredAssetsDataToDelete.AddUnique(AssetData);
+		Row->bIsChecked = true;
+		StoredAssetsDataToDelete.AddUnique(Row);
 		break;
 
 	case ECheckBoxState::Undetermined:
-		DebugHeader::PrintDebugMessage(AssetData->GetFullName() + TEXT(" undetermined"), FColor::Yellow);
+		DebugHeader::PrintDebugMessage(Row->AssetData->GetFullName() + TEXT(" undetermined"), FColor::Yellow);
 		break;
 
 	default:
@@ -279,62 +391,273 @@ TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructRowText(const FText& Conte
 	return ConstructedTextBlock;
 }
 
-TSharedRef<SComboBox<TSharedPtr<FText>>> SAdvancedDeletionTab::ConstructComboBox()
+TSharedRef<SComboButton> SAdvancedDeletionTab::ConstructFilterComboButton()
 {
-	TSharedRef<SComboBox<TSharedPtr<FText>>> ConstructedComboBox = SNew(SComboBox<TSharedPtr<FText>>)
-		.OptionsSource(&ComboBoxSourceItems)
-		// For the second argument (function binding) to work, needs to return a TSharedReference (see header)
-		.OnGenerateWidget(this, &SAdvancedDeletionTab::OnGenerateComboBoxContent)
-		.ToolTipText(LOCTEXT("ComboBoxTooltip", "Choose a list filter to narrow results."))
-		.OnSelectionChanged(this, &SAdvancedDeletionTab::OnComboBoxSelectionChanged)
+	TSharedRef<SComboButton> ConstructedComboButton = SNew(SComboButton)
+		.ToolTipText(LOCTEXT("ComboBoxTooltip", "Choose one or more list filters to narrow results."))
+		// The menu is rebuilt on every open, so the class entries always match the stored rows
+		.OnGetMenuContent(this, &SAdvancedDeletionTab::MakeFilterMenu)
+		.ButtonContent()
 		[
-			// SAssignNew is a specific macro for displaying combo box content. Arg1: member var, Arg2: slate class
-			SAssignNew(ComboBoxTextBlock, STextBlock)
-			.Text(LOCTEXT("FilterHint", "Select a Filter")) // The default display text of the combo box
+			SNew(STextBlock)
+			.Text(this, &SAdvancedDeletionTab::GetFilterButtonText)
 		];
 
-	return ConstructedComboBox;
+	return ConstructedComboButton;
 }
 
-TSharedRef<SWidget> SAdvancedDeletionTab::OnGenerateComboBoxContent(TSharedPtr<FText> SourceItem)
+TSharedRef<SSearchBox> SAdvancedDeletionTab::ConstructSearchBox()
 {
-	TSharedRef<STextBlock> ConstructedComboBoxText = SNew(STextBlock)
-	.Text(*SourceItem.Get());
+	TSharedRef<SSearchBox> ConstructedSearchBox = SNew(SSearchBox)
+		.HintText(LOCTEXT("SearchHint", "Search names and paths..."))
+		.ToolTipText(LOCTEXT("SearchTooltip", "Show only assets whose name or path contains the search text."))
+		.OnTextChanged(this, &SAdvancedDeletionTab::OnSearchTextChanged);
 
-	return ConstructedComboBoxText;
+	return ConstructedSearchBox;
 }
 
-void SAdvancedDeletionTab::OnComboBoxSelectionChanged(TSharedPtr<FText> SelectedOption, ESelectInfo::Type InSelectInfo)
+void SAdvancedDeletionTab::OnSearchTextChanged(const FText& InSearchText)
 {
+	SearchText = InSearchText.ToString();
 
-	if (SelectedOption.IsValid())
+	// Restart the delay on every keystroke, so fast typing only filters the list once
+	if (SearchTimerHandle.IsValid())
 	{
+		UnRegisterActiveTimer(SearchTimerHandle.ToSharedRef());
+	}
 
-		FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+	SearchTimerHandle = RegisterActiveTimer(SearchDelaySeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeletionTab::OnSearchTimerElapsed));
+}
 
-		ComboBoxTextBlock->SetText(*SelectedOption.Get());
+EActiveTimerReturnType SAdvancedDeletionTab::OnSearchTimerElapsed(double InCurrentTime, float InDeltaTime)
+{
+	SearchTimerHandle.Reset();
+	SearchIndex.Query(SearchText, SearchMatches);
+	UpdateDisplayedRows();
+
+	return EActiveTimerReturnType::Stop;
+}
 
-		// Pass data to the module to filter the list view
-		if (SelectedOption->EqualTo(LISTALL))
+void SAdvancedDeletionTab::UpdateDisplayedRows(bool bResetChecks)
+{
+	DisplayedAssetsData.Reset(FilteredAssetsData.Num());
+
+	// Filtered rows are already sorted, so keeping their order is enough and no re-sort is needed
+	for (const FDeletionListRowPtr& Row : FilteredAssetsData)
+	{
+		if (SearchMatches.IsValidIndex(Row->RowId) && SearchMatches[Row->RowId])
 		{
-			DisplayedAssetsData = StoredAssetsData;
-			// Unneeded? The list is updating properly without it
-			RefreshList();
+			DisplayedAssetsData.Add(Row);
 		}
-		else if (SelectedOption->EqualTo(LISTUNUSED))
+	}
+
+	DisplayedGroupHeaders.Reset();
+	const FDeletionListFilter* GroupingFilter = FilterPipeline.GetGroupingFilter();
+
+	if (GroupingFilter)
+	{
+		GroupingFilter->GroupRows(DisplayedAssetsData, DisplayedGroupHeaders);
+
+		// The search can leave a single row of a group, which is no duplicate of anything displayed
+		DisplayedAssetsData.Reset();
+
+		for (const FDeletionListRowPtr& GroupHeader : DisplayedGroupHeaders)
 		{
-			UdemyCourseModule.GetUnusedAssetsForList(StoredAssetsData, DisplayedAssetsData);
-			// Calling from FUdemyCourseModule::OnAdvancedDeletionButtonClicked(), instead.
-			// Calling here requires FixupRedirectors to have public access
-			//UdemyCourseModule.FixupRedirectors();
-			RefreshList();
+			DisplayedAssetsData.Append(GroupHeader->GroupChildren);
 		}
-		else if (SelectedOption->EqualTo(LISTDUPLICATES))
+	}
+
+	if (ConstructedList.IsValid())
+	{
+		ConstructedList->SetTreeItemsSource(GroupingFilter ? &DisplayedGroupHeaders : &DisplayedAssetsData);
+
+		// Headers are recreated on every update, so new groups start expanded
+		for (const FDeletionListRowPtr& GroupHeader : DisplayedGroupHeaders)
 		{
-			UdemyCourseModule.GetDuplicateNameAssets(StoredAssetsData, DisplayedAssetsData);
-			RefreshList();
+			ConstructedList->SetItemExpansion(GroupHeader, true);
 		}
 	}
+
+	RefreshList(bResetChecks);
+}
+
+TSharedRef<SWidget> SAdvancedDeletionTab::MakeFilterMenu()
+{
+	// Keep the menu open, so several filters can be stacked in one go
+	FMenuBuilder MenuBuilder(false, nullptr);
+
+	MenuBuilder.BeginSection(TEXT("Conditions"), LOCTEXT("ConditionsSection", "Conditions"));
+	AddFilterToggleEntry(MenuBuilder, FilterPipeline.UnusedFilter, LOCTEXT("UnusedFilterTooltip", "Show assets without any referencers."));
+	AddFilterToggleEntry(MenuBuilder, FilterPipeline.DuplicateNameFilter, LOCTEXT("DuplicateNameFilterTooltip", "Show assets sharing their name with another asset in the list."));
+	AddFilterToggleEntry(MenuBuilder, FilterPipeline.DuplicateContentFilter, LOCTEXT("DuplicateContentFilterTooltip", "Show assets whose saved content is byte-identical to another asset of the same class in the list."));
+	AddFilterToggleEntry(MenuBuilder, FilterPipeline.NearDuplicateTextureFilter, LOCTEXT("NearDuplicateTextureFilterTooltip", "Show textures that look alike, e.g. the same image at another resolution or compression. Loads textures that weren't hashed before."));
+	MenuBuilder.AddSubMenu(
+		LOCTEXT("ClassSubMenu", "Class"),
+		LOCTEXT("ClassSubMenuTooltip", "Show only the checked asset classes."),
+		FNewMenuDelegate::CreateSP(this, &SAdvancedDeletionTab::MakeClassFilterSubMenu)
+	);
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection(TEXT("Parameters"), LOCTEXT("ParametersSection", "Parameters"));
+	MenuBuilder.AddWidget(
+		SNew(SEditableTextBox)
+		.MinDesiredWidth(150.f)
+		.Text(FText::FromString(FilterPipeline.PathFilter->GetSubPath()))
+		.HintText(LOCTEXT("SubPathHint", "e.g. Textures/Props"))
+		.ToolTipText(LOCTEXT("SubPathTooltip", "Show only assets whose path contains this text. Clear it to disable the filter."))
+		.OnTextCommitted(this, &SAdvancedDeletionTab::OnSubPathCommitted),
+		LOCTEXT("SubPathLabel", "Sub-path")
+	);
+	MenuBuilder.AddWidget(
+		SNew(SNumericEntryBox<int32>)
+		.MinDesiredValueWidth(60.f)
+		.AllowSpin(false)
+		.MinValue(0)
+		.Value(this, &SAdvancedDeletionTab::GetMinSizeKB)
+		.ToolTipText(LOCTEXT("MinSizeTooltip", "Minimum disk size in KB, 0 disables the bound."))
+		.OnValueCommitted(this, &SAdvancedDeletionTab::OnMinSizeCommitted),
+		LOCTEXT("MinSizeLabel", "Min Size (KB)")
+	);
+	MenuBuilder.AddWidget(
+		SNew(SNumericEntryBox<int32>)
+		.MinDesiredValueWidth(60.f)
+		.AllowSpin(false)
+		.MinValue(0)
+		.Value(this, &SAdvancedDeletionTab::GetMaxSizeKB)
+		.ToolTipText(LOCTEXT("MaxSizeTooltip", "Maximum disk size in KB, 0 disables the bound."))
+		.OnValueCommitted(this, &SAdvancedDeletionTab::OnMaxSizeCommitted),
+		LOCTEXT("MaxSizeLabel", "Max Size (KB)")
+	);
+	AddFilterToggleEntry(MenuBuilder, FilterPipeline.ModifiedFilter, LOCTEXT("ModifiedFilterTooltip", "Show assets whose file hasn't been modified for the number of days below."));
+	MenuBuilder.AddWidget(
+		SNew(SSpinBox<int32>)
+		.MinDesiredWidth(60.f)
+		.MinValue(0)
+		.MaxValue(3650)
+		.Value(this, &SAdvancedDeletionTab::GetMinDaysUnmodified)
+		.OnValueCommitted(this, &SAdvancedDeletionTab::OnMinDaysUnmodifiedCommitted),
+		LOCTEXT("MinDaysUnmodifiedLabel", "Unmodified For (Days)")
+	);
+	MenuBuilder.EndSection();
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SAdvancedDeletionTab::MakeClassFilterSubMenu(FMenuBuilder& MenuBuilder)
+{
+	TSet<FName> UniqueClassNames;
+
+	for (const FDeletionListRowPtr& Row : StoredAssetsData)
+	{
+		UniqueClassNames.Add(Row->GetClassName());
+	}
+
+	TArray<FName> ClassNames = UniqueClassNames.Array();
+	ClassNames.Sort(FNameLexicalLess());
+
+	for (const FName& ClassName : ClassNames)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::FromName(ClassName),
+			FText::Format(LOCTEXT("ClassEntryTooltip", "Show {0} assets."), FText::FromName(ClassName)),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateSP(this, &SAdvancedDeletionTab::ToggleClassFilter, ClassName),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateSP(this, &SAdvancedDeletionTab::IsClassFiltered, ClassName)
+			),
+			NAME_None,
+			EUserInterfaceActionType::ToggleButton
+		);
+	}
+}
+
+void SAdvancedDeletionTab::AddFilterToggleEntry(FMenuBuilder& MenuBuilder, TSharedRef<FDeletionListFilter> Filter, const FText& ToolTip)
+{
+	MenuBuilder.AddMenuEntry(
+		Filter->GetDisplayName(),
+		ToolTip,
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateSP(this, &SAdvancedDeletionTab::ToggleFilter, Filter),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateSP(this, &SAdvancedDeletionTab::IsFilterEnabled, Filter)
+		),
+		NAME_None,
+		EUserInterfaceActionType::ToggleButton
+	);
+}
+
+FText SAdvancedDeletionTab::GetFilterButtonText() const
+{
+	const int32 NumEnabledFilters = FilterPipeline.GetNumEnabledFilters();
+
+	if (NumEnabledFilters == 0)
+	{
+		return LOCTEXT("FilterHint", "All Assets");
+	}
+
+	return FText::Format(LOCTEXT("ActiveFilters", "{0} {0}|plural(one=Filter,other=Filters) Active"), NumEnabledFilters);
+}
+
+void SAdvancedDeletionTab::ToggleFilter(TSharedRef<FDeletionListFilter> Filter)
+{
+	// Disabling keeps the memoized results, so toggling back on only re-evaluates outdated ones, e.g. after a cancelled hash pass
+	Filter->SetEnabled(!Filter->IsEnabled());
+	ApplyFilters();
+}
+
+void SAdvancedDeletionTab::ToggleClassFilter(FName ClassName)
+{
+	FilterPipeline.ClassFilter->ToggleClass(ClassName);
+	ApplyFilters();
+}
+
+void SAdvancedDeletionTab::OnSubPathCommitted(const FText& InText, ETextCommit::Type InCommitType)
+{
+	if (InText.ToString() == FilterPipeline.PathFilter->GetSubPath())
+	{
+		return;
+	}
+
+	FilterPipeline.PathFilter->SetSubPath(InText.ToString());
+	ApplyFilters();
+}
+
+void SAdvancedDeletionTab::OnMinSizeCommitted(int32 InValue, ETextCommit::Type InCommitType)
+{
+	FilterPipeline.SizeFilter->SetSizeRangeKB(InValue > 0 ? TOptional<int32>(InValue) : TOptional<int32>(), GetMaxSizeKB());
+	ApplyFilters();
+}
+
+void SAdvancedDeletionTab::OnMaxSizeCommitted(int32 InValue, ETextCommit::Type InCommitType)
+{
+	FilterPipeline.SizeFilter->SetSizeRangeKB(GetMinSizeKB(), InValue > 0 ? TOptional<int32>(InValue) : TOptional<int32>());
+	ApplyFilters();
+}
+
+void SAdvancedDeletionTab::OnMinDaysUnmodifiedCommitted(int32 InValue, ETextCommit::Type InCommitType)
+{
+	if (InValue == GetMinDaysUnmodified())
+	{
+		return;
+	}
+
+	FilterPipeline.ModifiedFilter->SetMinDaysUnmodified(InValue);
+
+	// Only the parameter changed, the filter stays toggled the way the user left it
+	if (FilterPipeline.ModifiedFilter->IsEnabled())
+	{
+		ApplyFilters();
+	}
+}
+
+void SAdvancedDeletionTab::ApplyFilters(bool bResetChecks)
+{
+	FilterPipeline.Apply(StoredAssetsData, NextRowId, FilteredAssetsData);
+	// Keep the current column sort after the filters change
+	SortFilteredRows();
+	UpdateDisplayedRows(bResetChecks);
 }
 
 TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructButtonText(const FText& ContentText)
@@ -400,6 +723,8 @@ TSharedRef<SButton> SAdvancedDeletionTab::ConstructDeleteSelectedButton()
 		.HAlign(EHorizontalAlignment::HAlign_Center)
 		//.Text(LOCTEXT("DeleteSelected", "Delete Selected"))
 		.ToolTipText(LOCTEXT("DeleteSelectedTooltip", "Deletes all assets in the current list."))
+		// Disabled while a background deletion is running
+		.IsEnabled(this, &SAdvancedDeletionTab::CanDeleteSelected)
 		.OnClicked(this, &SAdvancedDeletionTab::OnDeleteSelectedButtonClicked);
 
 	// TODO: This seems to be a waste and is overly-modular, using .Text() and .Font() from above slate code is fine
@@ -407,12 +732,190 @@ TSharedRef<SButton> SAdvancedDeletionTab::ConstructDeleteSelectedButton()
 	return ConstructedDeleteSelectedButton;
 }
 
-TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvancedDeletionTab::ConstructList()
+TSharedRef<SWidget> SAdvancedDeletionTab::ConstructThumbnail(const FDeletionListRowPtr& RowToDisplay)
+{
+	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+
+	// The widget owns the thumbnail, so it is released back to the pool once the row scrolls out of view.
+	// The pool renders it over the next frames and evicts the least recently used textures when full
+	TSharedRef<FAssetThumbnail> AssetThumbnail = MakeShared<FAssetThumbnail>(*RowToDisplay->AssetData, ThumbnailSize, ThumbnailSize, UdemyCourseModule.GetThumbnailPool());
+
+	FAssetThumbnailConfig ThumbnailConfig;
+	ThumbnailConfig.bAllowFadeIn = true;
+
+	return SNew(SBox)
+		.WidthOverride(ThumbnailSize)
+		.HeightOverride(ThumbnailSize)
+		[
+			AssetThumbnail->MakeThumbnailWidget(ThumbnailConfig)
+		];
+}
+
+ECheckBoxState SAdvancedDeletionTab::GetShowThumbnailsState() const
+{
+	return bShowThumbnails ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SAdvancedDeletionTab::OnShowThumbnailsChanged(ECheckBoxState NewState)
+{
+	bShowThumbnails = NewState == ECheckBoxState::Checked;
+
+	if (!ConstructedHeaderRow.IsValid() || !ConstructedList.IsValid())
+	{
+		return;
+	}
+
+	if (bShowThumbnails)
+	{
+		// Right after the check box column
+		ConstructedHeaderRow->InsertColumn(
+			SHeaderRow::Column(AdvancedDeletionColumns::Thumbnail)
+			.DefaultLabel(FText::GetEmpty())
+			.FixedWidth(ThumbnailSize + 8.f)
+			.HAlignCell(HAlign_Center)
+			.VAlignCell(VAlign_Center),
+			1
+		);
+	}
+	else
+	{
+		ConstructedHeaderRow->RemoveColumn(AdvancedDeletionColumns::Thumbnail);
+	}
+
+	// Existing row widgets were built for the old columns
+	ConstructedList->RebuildList();
+}
+
+TSharedRef<SHeaderRow> SAdvancedDeletionTab::ConstructHeaderRow()
+{
+	ConstructedHeaderRow = SNew(SHeaderRow)
+		+SHeaderRow::Column(AdvancedDeletionColumns::CheckBox)
+		.DefaultLabel(FText::GetEmpty())
+		.FixedWidth(24.f)
+		.HAlignCell(HAlign_Center)
+		.VAlignCell(VAlign_Center)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::Class)
+		.DefaultLabel(LOCTEXT("ClassColumn", "Class"))
+		.FillWidth(0.15f)
+		.VAlignCell(VAlign_Center)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, AdvancedDeletionColumns::Class)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::Name)
+		.DefaultLabel(LOCTEXT("NameColumn", "Name"))
+		.FillWidth(0.3f)
+		.VAlignCell(VAlign_Center)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, AdvancedDeletionColumns::Name)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::Path)
+		.DefaultLabel(LOCTEXT("PathColumn", "Path"))
+		.FillWidth(0.3f)
+		.VAlignCell(VAlign_Center)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, AdvancedDeletionColumns::Path)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::DiskSize)
+		.DefaultLabel(LOCTEXT("DiskSizeColumn", "Disk Size"))
+		.FillWidth(0.1f)
+		.VAlignCell(VAlign_Center)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, AdvancedDeletionColumns::DiskSize)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::Referencers)
+		.DefaultLabel(LOCTEXT("ReferencersColumn", "Referencers"))
+		.FillWidth(0.1f)
+		.VAlignCell(VAlign_Center)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, AdvancedDeletionColumns::Referencers)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(AdvancedDeletionColumns::Delete)
+		.DefaultLabel(FText::GetEmpty())
+		.FixedWidth(90.f)
+		.HAlignCell(HAlign_Right);
+
+	return ConstructedHeaderRow.ToSharedRef();
+}
+
+EColumnSortMode::Type SAdvancedDeletionTab::GetColumnSortMode(const FName ColumnId) const
+{
+	return SortColumn == ColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SAdvancedDeletionTab::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = NewSortMode;
+
+	SortFilteredRows();
+	UpdateDisplayedRows();
+}
+
+void SAdvancedDeletionTab::SortFilteredRows()
 {
-	ConstructedList = SNew(SListView<TSharedPtr<FAssetData>>)
+	if (SortColumn.IsNone() || SortMode == EColumnSortMode::None)
+	{
+		return;
+	}
+
+	if (bSortRanksDirty)
+	{
+		FDeletionListRow::BuildSortRanks(StoredAssetsData);
+		bSortRanksDirty = false;
+	}
+
+	// Only the integer keys cached on each row are compared, ties fall back to the name rank for a stable order
+	auto SortByKey = [this](auto GetKey)
+	{
+		const bool bAscending = SortMode == EColumnSortMode::Ascending;
+
+		Algo::Sort(FilteredAssetsData, [&GetKey, bAscending](const FDeletionListRowPtr& A, const FDeletionListRowPtr& B)
+		{
+			const auto KeyA = GetKey(*A);
+			const auto KeyB = GetKey(*B);
+
+			if (KeyA == KeyB)
+			{
+				return A->NameRank < B->NameRank;
+			}
+
+			return bAscending ? KeyA < KeyB : KeyB < KeyA;
+		});
+	};
+
+	if (SortColumn == AdvancedDeletionColumns::Class)
+	{
+		SortByKey([](const FDeletionListRow& Row) {return Row.ClassRank;});
+	}
+	else if (SortColumn == AdvancedDeletionColumns::Name)
+	{
+		SortByKey([](const FDeletionListRow& Row) {return Row.NameRank;});
+	}
+	else if (SortColumn == AdvancedDeletionColumns::Path)
+	{
+		SortByKey([](const FDeletionListRow& Row) {return Row.PathRank;});
+	}
+	else if (SortColumn == AdvancedDeletionColumns::DiskSize)
+	{
+		SortByKey([](const FDeletionListRow& Row) {return Row.DiskSize;});
+	}
+	else if (SortColumn == AdvancedDeletionColumns::Referencers)
+	{
+		SortByKey([](const FDeletionListRow& Row) {return Row.ReferencerCount;});
+	}
+}
+
+TSharedRef<STreeView<FDeletionListRowPtr>> SAdvancedDeletionTab::ConstructList()
+{
+	// A tree, so duplicate filters can show their results under collapsible group headers. Without grouping
+	// the items are the displayed rows themselves, which have no children, and it behaves like a list
+	ConstructedList = SNew(STreeView<FDeletionListRowPtr>)
 		//.ItemHeight(24.f) // Warning C4996: Soon-deprecated API member
-		.ListItemsSource(&DisplayedAssetsData)
+		.TreeItemsSource(&DisplayedAssetsData)
+		.HeaderRow(ConstructHeaderRow())
 		.OnGenerateRow(this, &SAdvancedDeletionTab::OnGenerateRowForList)
+		.OnGetChildren(this, &SAdvancedDeletionTab::OnGetChildrenForList)
 		.ScrollBarPadding(FMargin(6.f, 0.f)) // Padding to start content away from scrollbar
 		.ToolTipText(LOCTEXT("RowTooltip", "Select one or more rows to select assets in the content browser."))
 		// Better than .OnMouseButtonClicke(), which is single-selection
@@ -423,57 +926,42 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvancedDeletionTab::ConstructLis
 	return ConstructedList.ToSharedRef();
 }
 
-TSharedRef<SButton> SAdvancedDeletionTab::ConstructButtonForRow(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+TSharedRef<SButton> SAdvancedDeletionTab::ConstructButtonForRow(const FDeletionListRowPtr& RowToDisplay)
 {
 	TSharedRef<SButton> ConstructedButton = SNew(SButton)
 		.Text(LOCTEXT("Delete", "Delete Item"))
 		.ToolTipText(LOCTEXT("DeleteRowButtonTooltip", "Delete the single asset in the row."))
 		.HAlign(HAlign_Center)
 		.VAlign(VAlign_Fill)
-		.OnClicked(this, &SAdvancedDeletionTab::OnDeleteButtonClicked, AssetDataToDisplay);
+		.OnClicked(this, &SAdvancedDeletionTab::OnDeleteButtonClicked, RowToDisplay);
 
 	return ConstructedButton;
 }
 
-FReply SAdvancedDeletionTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+FReply SAdvancedDeletionTab::OnDeleteButtonClicked(FDeletionListRowPtr ClickedRow)
 {
 	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
 
-	if (ClickedAssetData.IsValid())
+	if (ClickedRow.IsValid())
 	{
+		const TSharedPtr<FAssetData>& ClickedAssetData = ClickedRow->AssetData;
 		const bool bAssetDeleted = UdemyCourseModule.DeleteAssetFromWidget(*ClickedAssetData.Get());
 
 		if (bAssetDeleted)
 		{
-			if (StoredAssetsData.Contains(ClickedAssetData))
-			{
-				// Update the displayed results, as well, which will take the current filter into account
-				if (DisplayedAssetsData.Contains(ClickedAssetData))
-				{
-					DisplayedAssetsData.Remove(ClickedAssetData);
-				}
-
-				StoredAssetsData.Remove(ClickedAssetData);
-				DebugHeader::ShowNotification(
-					FText::Format(
-						LOCTEXT("AssetDeleted", "Asset deleted: {0}"),
-						FText::FromString(ClickedAssetData->GetObjectPathString())
-					)
-				);
-
-				// Refresh the list to remove the deleted asset's row
-				RefreshList();
-			}
-			else
-			{
-				DebugHeader::ShowNotification(
-					FText::Format(
-						LOCTEXT("AssetNotDeleted", "Asset {0} was not found, skipping deletion"),
-						FText::FromString(ClickedAssetData->GetObjectPathString())
-					),
-					ELogVerbosity::Error
-				);
-			}
+			// The registry event may have removed the row already, in which case this is a no-op
+			RemoveRowForAsset(ClickedAssetData->GetSoftObjectPath());
+			FlushRemovedRows();
+			DebugHeader::ShowNotification(
+				FText::Format(
+					LOCTEXT("AssetDeleted", "Asset deleted: {0}"),
+					FText::FromString(ClickedAssetData->GetObjectPathString())
+				)
+			);
+
+			// Re-run the filters, which will drop the deleted asset's row from the displayed results
+			FilterPipeline.OnRowsRemoved();
+			ApplyFilters(false);
 		}
 	}
 
@@ -482,32 +970,88 @@ FReply SAdvancedDeletionTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> Clicke
 
 FReply SAdvancedDeletionTab::OnSelectAllButtonClicked()
 {
-	if (ConstructedCheckBoxes.IsEmpty())
+	// Checks every displayed row, including the ones scrolled out of view which have no widget.
+	// The check boxes read the row state, so no widget needs to be touched
+	for (const FDeletionListRowPtr& Row : DisplayedAssetsData)
 	{
-		return FReply::Handled(); 
+		if (!Row->bIsChecked)
+		{
+			Row->bIsChecked = true;
+			StoredAssetsDataToDelete.Add(Row);
+		}
 	}
 
-	// Iterate over the check box pointers and call the set the checkbox state to checked 
-	for (const TSharedRef<SCheckBox>& CheckBoxRef : ConstructedCheckBoxes)
+	return FReply::Handled();
+}
+
+FReply SAdvancedDeletionTab::OnDeselectAllButtonClicked()
+{
+	ClearCheckedRows();
+	return FReply::Handled();
+}
+
+void SAdvancedDeletionTab::ClearCheckedRows()
+{
+	for (const FDeletionListRowPtr& Row : StoredAssetsDataToDelete)
 	{
-		CheckBoxRef->SetIsChecked(ECheckBoxState::Checked);
+		Row->bIsChecked = false;
 	}
 
-	return FReply::Handled();
+	StoredAssetsDataToDelete.Empty();
 }
 
-FReply SAdvancedDeletionTab::OnDeselectAllButtonClicked()
+TSharedRef<SButton> SAdvancedDeletionTab::ConstructExportButton()
+{
+	TSharedRef<SButton> ConstructedExportButton = SNew(SButton)
+		.HAlign(HAlign_Center)
+		.ToolTipText(LOCTEXT("ExportTooltip", "Saves the listed assets with their class, path, size and referencer count to a CSV or JSON file."))
+		.OnClicked(this, &SAdvancedDeletionTab::OnExportButtonClicked);
+
+	ConstructedExportButton->SetContent(ConstructButtonText(LOCTEXT("Export", "Export...")));
+	return ConstructedExportButton;
+}
+
+FReply SAdvancedDeletionTab::OnExportButtonClicked()
 {
-	if (ConstructedCheckBoxes.IsEmpty())
+	if (DisplayedAssetsData.IsEmpty())
 	{
+		DebugHeader::ShowNotification(LOCTEXT("ExportEmptyWarning", "There are no assets in the list, skipping export."), ELogVerbosity::Warning);
 		return FReply::Handled();
 	}
 
-	for (const TSharedRef<SCheckBox>& CheckBoxRef : ConstructedCheckBoxes)
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+
+	if (!DesktopPlatform)
 	{
-		CheckBoxRef->SetIsChecked(ECheckBoxState::Unchecked);
+		return FReply::Handled();
 	}
 
+	TArray<FString> Filenames;
+	const bool bFileChosen = DesktopPlatform->SaveFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared()),
+		LOCTEXT("ExportDialogTitle", "Export Asset List").ToString(),
+		FPaths::ProjectSavedDir(),
+		TEXT("AssetList.csv"),
+		TEXT("CSV file (*.csv)|*.csv|JSON file (*.json)|*.json"),
+		EFileDialogFlags::None,
+		Filenames
+	);
+
+	if (!bFileChosen || Filenames.IsEmpty())
+	{
+		return FReply::Handled();
+	}
+
+	const FString& Filename = Filenames[0];
+	const bool bExported = FDeletionListExporter::ExportRows(DisplayedAssetsData, Filename, FDeletionListExporter::GetFormatForFilename(Filename));
+
+	DebugHeader::ShowNotification(
+		bExported
+			? FText::Format(LOCTEXT("ExportSucceeded", "Exported {0} asset(s) to {1}"), DisplayedAssetsData.Num(), FText::FromString(Filename))
+			: FText::Format(LOCTEXT("ExportFailed", "Could not write {0}. See the output log for details."), FText::FromString(Filename)),
+		bExported ? ELogVerbosity::Log : ELogVerbosity::Error
+	);
+
 	return FReply::Handled();
 }
 
@@ -528,71 +1072,331 @@ FReply SAdvancedDeletionTab::OnDeleteSelectedButtonClicked()
 	TArray<FAssetData> AssetsDataToDelete;
 
 	// Convert the array data to a non-pointer
-	for (const TSharedPtr<FAssetData>& AssetData : StoredAssetsDataToDelete)
+	for (const FDeletionListRowPtr& Row : StoredAssetsDataToDelete)
 	{
-		AssetsDataToDelete.Add(*AssetData.Get());
+		AssetsDataToDelete.Add(*Row->AssetData.Get());
 	}
 
-	// Pass data to the module for deletion
+	const FText ConfirmMessage = FAssetQuarantine::IsEnabled()
+		? FText::Format(LOCTEXT("QuarantineSelectedConfirm", "Move {0} checked asset(s) to {1}?\nAssets still referenced by other assets are skipped."), AssetsDataToDelete.Num(), FText::FromString(FAssetQuarantine::GetQuarantinePath()))
+		: FText::Format(LOCTEXT("DeleteSelectedConfirm", "Delete {0} checked asset(s)?\nAssets still referenced by other assets are skipped."), AssetsDataToDelete.Num());
+
+	if (FMessageDialog::Open(EAppMsgType::YesNo, ConfirmMessage) != EAppReturnType::Yes)
+	{
+		return FReply::Handled();
+	}
+
+	// Pass data to the module, which deletes in the background and reports back when done
 	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
-	const bool bAssetsDeleted = UdemyCourseModule.DeleteCheckedWidgetAssets(AssetsDataToDelete);
+	UdemyCourseModule.StartAssetDeletionPipeline(AssetsDataToDelete, FOnAssetDeletionFinished::CreateSP(this, &SAdvancedDeletionTab::OnAssetDeletionFinished));
 
-	if (bAssetsDeleted)
+	return FReply::Handled();
+}
+
+void SAdvancedDeletionTab::OnAssetDeletionFinished(const FAssetDeletionResult& DeletionResult)
+{
+	if (!DeletionResult.HasDeletedAny())
 	{
-		// Clear the dangling pointers
-		for (const TSharedPtr<FAssetData>& DanglingData : StoredAssetsDataToDelete)
-		{
-			// Compare to the list pointers and sync the data
-			if (StoredAssetsData.Contains(DanglingData))
-			{
-				StoredAssetsData.Remove(DanglingData);
-			}
+		return;
+	}
 
-			if (DisplayedAssetsData.Contains(DanglingData))
-			{
-				DisplayedAssetsData.Remove(DanglingData);
-			}
-		}
-		
-		// Refresh the list after any assets have been deleted
-		RefreshList();
+	// Clear the dangling pointers. Rows already dropped by registry events are skipped
+	for (const FAssetData& DeletedAsset : DeletionResult.DeletedAssets)
+	{
+		RemoveRowForAsset(DeletedAsset.GetSoftObjectPath());
 	}
 
-	return FReply::Handled();
+	FlushRemovedRows();
+
+	// Refresh the list after any assets have been deleted. Failed rows keep their widgets, so they stay checked for a retry
+	FilterPipeline.OnRowsRemoved();
+	ApplyFilters(false);
+}
+
+bool SAdvancedDeletionTab::CanDeleteSelected() const
+{
+	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+	return !UdemyCourseModule.IsAssetDeletionRunning();
+}
+
+void SAdvancedDeletionTab::OnAssetListViewSelectionChanged(FDeletionListRowPtr SelectedItems, ESelectInfo::Type SelectInfo)
+{
+	// Restart the delay on every change, a drag select over hundreds of rows then syncs the Content Browser once
+	if (SelectionSyncTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(SelectionSyncTimerHandle.ToSharedRef());
+	}
+
+	SelectionSyncTimerHandle = RegisterActiveTimer(SelectionSyncDelaySeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeletionTab::OnSelectionSyncTimerElapsed));
 }
 
-void SAdvancedDeletionTab::OnAssetListViewSelectionChanged(TSharedPtr<FAssetData> SelectedItems, ESelectInfo::Type SelectInfo)
+EActiveTimerReturnType SAdvancedDeletionTab::OnSelectionSyncTimerElapsed(double InCurrentTime, float InDeltaTime)
 {
-	// ClickedRowAssets is initialized in the constructor, safe to access directly without valid check
-	ClickedRowAssets->Empty();
+	SelectionSyncTimerHandle.Reset();
 
-	TArray<TSharedPtr<FAssetData>> CurrentSelectedItems;
+	TArray<FDeletionListRowPtr> CurrentSelectedItems;
 	ConstructedList->GetSelectedItems(CurrentSelectedItems);
 
 	// Iterate over each selected item and add its object path for syncing the CB
-	for (const TSharedPtr<FAssetData>& AssetData : CurrentSelectedItems)
+	TArray<FString> SelectedRowAssets;
+	SelectedRowAssets.Reserve(CurrentSelectedItems.Num());
+
+	for (const FDeletionListRowPtr& Row : CurrentSelectedItems)
 	{
-		if (AssetData.IsValid())
+		if (Row.IsValid() && !Row->IsGroupHeader())
 		{
-			ClickedRowAssets->Add(AssetData->GetObjectPathString());
+			SelectedRowAssets.Add(Row->AssetData->GetObjectPathString());
 		}
 	}
 
-	FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
-	UdemyCourseModule.SyncCBToSelectedRows(*ClickedRowAssets);
+	const int32 MaxSyncSelection = GetDefault<UUdemyCourseSettings>()->MaxContentBrowserSyncSelection;
+
+	if (MaxSyncSelection > 0 && SelectedRowAssets.Num() > MaxSyncSelection)
+	{
+		UE_LOG(LogUdemyCourse, Verbose, TEXT("Skipped Content Browser sync, %d selected rows are above the limit of %d"), SelectedRowAssets.Num(), MaxSyncSelection);
+		return EActiveTimerReturnType::Stop;
+	}
+
+	// ClickedRowAssets is initialized in the constructor and holds the last synced selection, an unchanged one isn't synced again
+	if (SelectedRowAssets == *ClickedRowAssets)
+	{
+		return EActiveTimerReturnType::Stop;
+	}
+
+	*ClickedRowAssets = MoveTemp(SelectedRowAssets);
+
+	// Clicking a group header alone clears the selected assets, the Content Browser is left where it is
+	if (!ClickedRowAssets->IsEmpty())
+	{
+		FUdemyCourseModule& UdemyCourseModule = FModuleManager::LoadModuleChecked<FUdemyCourseModule>(TEXT("UdemyCourse"));
+		UdemyCourseModule.SyncCBToSelectedRows(*ClickedRowAssets);
+	}
+
+	return EActiveTimerReturnType::Stop;
 }
 
-void SAdvancedDeletionTab::RefreshList()
+void SAdvancedDeletionTab::RefreshList(bool bResetChecks)
 {
-	// Clear any danging pointers from memory
-	StoredAssetsDataToDelete.Empty();
-	ConstructedCheckBoxes.Empty();
+	// A new filter or search shows a different set of rows, so old checks could delete assets no longer visible
+	if (bResetChecks)
+	{
+		ClearCheckedRows();
+	}
 
+	// Only rows entering the view get new widgets, the others are kept as they are
 	if (ConstructedList.IsValid())
 	{
-		ConstructedList->RebuildList();
+		ConstructedList->RequestListRefresh();
+	}
+}
+
+#pragma region RegistrySync
+
+bool SAdvancedDeletionTab::IsInWatchedPath(const FAssetData& AssetData) const
+{
+	return IsInWatchedPath(AssetData.PackagePath.ToString());
+}
+
+bool SAdvancedDeletionTab::IsInWatchedPath(const FString& PackagePath) const
+{
+	// Assets are listed recursively, so sub-folders of the watched path count as well. Moving into the quarantine counts as a delete
+	if (FAssetQuarantine::IsInQuarantine(PackagePath))
+	{
+		return false;
+	}
+
+	return PackagePath == WatchedPath || (PackagePath.StartsWith(WatchedPath) && PackagePath[WatchedPath.Len()] == TEXT('/'));
+}
+
+void SAdvancedDeletionTab::OnRegistryAssetAdded(const FAssetData& AssetData)
+{
+	if (IsInWatchedPath(AssetData))
+	{
+		QueueRegistryChange({FPendingRegistryChange::EType::Added, AssetData, FSoftObjectPath()});
+	}
+}
+
+void SAdvancedDeletionTab::OnRegistryAssetRemoved(const FAssetData& AssetData)
+{
+	if (IsInWatchedPath(AssetData))
+	{
+		QueueRegistryChange({FPendingRegistryChange::EType::Removed, AssetData, FSoftObjectPath()});
+	}
+}
+
+void SAdvancedDeletionTab::OnRegistryAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// Moving an asset out of the folder is a rename too, so either side being listed matters
+	const FSoftObjectPath OldPath(OldObjectPath);
+
+	if (IsInWatchedPath(AssetData) || RowsByObjectPath.Contains(OldPath))
+	{
+		QueueRegistryChange({FPendingRegistryChange::EType::Renamed, AssetData, OldPath});
+	}
+}
+
+void SAdvancedDeletionTab::OnRegistryAssetUpdated(const FAssetData& AssetData)
+{
+	if (RowsByObjectPath.Contains(AssetData.GetSoftObjectPath()))
+	{
+		QueueRegistryChange({FPendingRegistryChange::EType::Updated, FAssetData(), FSoftObjectPath()});
+	}
+}
+
+void SAdvancedDeletionTab::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	// A save changes the file timestamp, the cached content hashes of the package are recomputed on the next evaluation
+	if (Package && IsInWatchedPath(FPackageName::GetLongPackagePath(Package->GetName())))
+	{
+		QueueRegistryChange({FPendingRegistryChange::EType::Updated, FAssetData(), FSoftObjectPath()});
 	}
 }
 
+void SAdvancedDeletionTab::QueueRegistryChange(FPendingRegistryChange&& Change)
+{
+	PendingRegistryChanges.Add(MoveTemp(Change));
+
+	if (!RegistryChangesTimerHandle.IsValid())
+	{
+		RegistryChangesTimerHandle = RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeletionTab::OnApplyRegistryChanges));
+	}
+}
+
+EActiveTimerReturnType SAdvancedDeletionTab::OnApplyRegistryChanges(double InCurrentTime, float InDeltaTime)
+{
+	RegistryChangesTimerHandle.Reset();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const int32 FirstNewRowId = NextRowId;
+	bool bRowsRemoved = false;
+	bool bPackagesChanged = false;
+
+	// Applied in arrival order, an asset can be added and removed again within the same frame
+	for (const FPendingRegistryChange& Change : PendingRegistryChanges)
+	{
+		switch (Change.Type)
+		{
+		case FPendingRegistryChange::EType::Added:
+			AddRowForAsset(Change.AssetData, AssetRegistry);
+			break;
+
+		case FPendingRegistryChange::EType::Removed:
+			bRowsRemoved |= RemoveRowForAsset(Change.AssetData.GetSoftObjectPath());
+			break;
+
+		case FPendingRegistryChange::EType::Renamed:
+		{
+			// A renamed asset gets a fresh row, its memoized filter and search results keyed by RowId are stale
+			const FDeletionListRowPtr OldRow = RowsByObjectPath.FindRef(Change.OldObjectPath);
+			bRowsRemoved |= RemoveRowForAsset(Change.OldObjectPath);
+
+			if (IsInWatchedPath(Change.AssetData))
+			{
+				const FDeletionListRowPtr NewRow = AddRowForAsset(Change.AssetData, AssetRegistry);
+
+				// Carry the check over, the user still means the same asset
+				if (NewRow.IsValid() && OldRow.IsValid() && OldRow->bIsChecked)
+				{
+					NewRow->bIsChecked = true;
+					StoredAssetsDataToDelete.Add(NewRow);
+				}
+			}
+			break;
+		}
+
+		case FPendingRegistryChange::EType::Updated:
+			bPackagesChanged = true;
+			break;
+		}
+	}
+
+	PendingRegistryChanges.Empty();
+	FlushRemovedRows();
+
+	const bool bRowsAdded = NextRowId > FirstNewRowId;
+
+	if (!bRowsAdded && !bRowsRemoved && !bPackagesChanged)
+	{
+		return EActiveTimerReturnType::Stop;
+	}
+
+	if (bRowsAdded)
+	{
+		bSortRanksDirty = true;
+
+		// Search results of the new rows, re-querying is cheap as it goes through the index
+		if (SearchText.IsEmpty())
+		{
+			SearchMatches.Add(true, NextRowId - SearchMatches.Num());
+		}
+		else
+		{
+			SearchIndex.Query(SearchText, SearchMatches);
+		}
+	}
+
+	if (bRowsRemoved)
+	{
+		FilterPipeline.OnRowsRemoved();
+	}
+
+	if (bPackagesChanged)
+	{
+		FilterPipeline.OnPackagesChanged();
+	}
+
+	// Per-row filters only evaluate the new RowIds, the list keeps the widgets of unchanged rows
+	ApplyFilters(false);
+
+	return EActiveTimerReturnType::Stop;
+}
+
+FDeletionListRowPtr SAdvancedDeletionTab::AddRowForAsset(const FAssetData& AssetData, IAssetRegistry& AssetRegistry)
+{
+	const FSoftObjectPath ObjectPath = AssetData.GetSoftObjectPath();
+
+	if (!AssetData.IsValid() || RowsByObjectPath.Contains(ObjectPath))
+	{
+		return nullptr;
+	}
+
+	FDeletionListRowPtr Row = FDeletionListRow::Make(MakeShared<FAssetData>(AssetData), AssetRegistry);
+	Row->RowId = NextRowId++;
+	SearchIndex.AddRow(*Row);
+
+	StoredAssetsData.Add(Row);
+	RowsByObjectPath.Add(ObjectPath, Row);
+	return Row;
+}
+
+bool SAdvancedDeletionTab::RemoveRowForAsset(const FSoftObjectPath& ObjectPath)
+{
+	FDeletionListRowPtr Row;
+
+	if (!RowsByObjectPath.RemoveAndCopyValue(ObjectPath, Row))
+	{
+		return false;
+	}
+
+	RemovedRowIds.Add(Row->RowId);
+	return true;
+}
+
+void SAdvancedDeletionTab::FlushRemovedRows()
+{
+	if (RemovedRowIds.IsEmpty())
+	{
+		return;
+	}
+
+	// One pass over each array for the whole burst, instead of a linear search per removed row
+	auto IsRemoved = [this](const FDeletionListRowPtr& Row) {return RemovedRowIds.Contains(Row->RowId);};
+	StoredAssetsData.RemoveAll(IsRemoved);
+	StoredAssetsDataToDelete.RemoveAll(IsRemoved);
+	RemovedRowIds.Reset();
+}
+
+#pragma endregion
+
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
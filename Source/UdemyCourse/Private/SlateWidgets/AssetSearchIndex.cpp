@@ -0,0 +1,136 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "SlateWidgets/AssetSearchIndex.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+void FAssetSearchIndex::Build(const TArray<FDeletionListRowPtr>& Rows)
+{
+	SearchKeys.Reset();
+	NGramPostings.Reset();
+
+	// RowIds are handed out in ascending order, so the postings stay sorted without an extra pass
+	for (const FDeletionListRowPtr& Row : Rows)
+	{
+		if (SearchKeys.Num() <= Row->RowId)
+		{
+			SearchKeys.SetNum(Row->RowId + 1);
+		}
+
+		SearchKeys[Row->RowId] = MakeSearchKey(*Row->AssetData);
+		IndexNGrams(Row->RowId);
+	}
+}
+
+void FAssetSearchIndex::AddRow(const FDeletionListRow& Row)
+{
+	if (SearchKeys.Num() <= Row.RowId)
+	{
+		SearchKeys.SetNum(Row.RowId + 1);
+	}
+
+	SearchKeys[Row.RowId] = MakeSearchKey(*Row.AssetData);
+	IndexNGrams(Row.RowId);
+}
+
+void FAssetSearchIndex::Query(const FString& InQuery, TBitArray<>& OutMatches) const
+{
+	const FString Needle = InQuery.TrimStartAndEnd().ToLower();
+
+	if (Needle.IsEmpty())
+	{
+		OutMatches.Init(true, SearchKeys.Num());
+		return;
+	}
+
+	OutMatches.Init(false, SearchKeys.Num());
+
+	// A query no longer than a trigram is an n-gram itself, so its postings are exactly the matching rows
+	if (Needle.Len() <= TrigramLength)
+	{
+		if (const TArray<int32>* Postings = NGramPostings.Find(PackNGram(*Needle, Needle.Len())))
+		{
+			for (const int32 RowId : *Postings)
+			{
+				OutMatches[RowId] = true;
+			}
+		}
+
+		return;
+	}
+
+	// Only the rows of the rarest trigram can contain the whole query
+	const TArray<int32>* SmallestPostings = nullptr;
+
+	for (int32 CharIndex = 0; CharIndex + TrigramLength <= Needle.Len(); ++CharIndex)
+	{
+		const TArray<int32>* Postings = NGramPostings.Find(PackNGram(*Needle + CharIndex, TrigramLength));
+
+		// No row contains this trigram, so nothing can match
+		if (!Postings)
+		{
+			return;
+		}
+
+		if (!SmallestPostings || Postings->Num() < SmallestPostings->Num())
+		{
+			SmallestPostings = Postings;
+		}
+	}
+
+	for (const int32 RowId : *SmallestPostings)
+	{
+		// Keys are already lower-case, so the cheaper case-sensitive compare is enough
+		if (SearchKeys[RowId].Contains(Needle, ESearchCase::CaseSensitive))
+		{
+			OutMatches[RowId] = true;
+		}
+	}
+}
+
+FString FAssetSearchIndex::MakeSearchKey(const FAssetData& AssetData)
+{
+	FString SearchKey = AssetData.AssetName.ToString();
+	SearchKey.AppendChar(TEXT('\n'));
+	AssetData.PackagePath.AppendString(SearchKey);
+	SearchKey.ToLowerInline();
+
+	return SearchKey;
+}
+
+uint64 FAssetSearchIndex::PackNGram(const TCHAR* Chars, int32 Length)
+{
+	// 21 bits per character covers every code point, whatever the size of TCHAR is on the platform.
+	// Keys never contain a null character, so n-grams of different lengths can't share a packed value
+	uint64 Packed = 0;
+
+	for (int32 CharIndex = 0; CharIndex < Length; ++CharIndex)
+	{
+		Packed |= static_cast<uint64>(Chars[CharIndex] & 0x1FFFFF) << (21 * CharIndex);
+	}
+
+	return Packed;
+}
+
+void FAssetSearchIndex::IndexNGrams(int32 RowId)
+{
+	const FString& SearchKey = SearchKeys[RowId];
+	TArray<uint64, TInlineAllocator<384>> RowNGrams;
+
+	for (int32 Length = 1; Length <= TrigramLength; ++Length)
+	{
+		for (int32 CharIndex = 0; CharIndex + Length <= SearchKey.Len(); ++CharIndex)
+		{
+			RowNGrams.Add(PackNGram(*SearchKey + CharIndex, Length));
+		}
+	}
+
+	// A row is added once per n-gram, even if the n-gram repeats in its name or path
+	Algo::Sort(RowNGrams);
+	RowNGrams.SetNum(Algo::Unique(RowNGrams));
+
+	for (const uint64 NGram : RowNGrams)
+	{
+		NGramPostings.FindOrAdd(NGram).Add(RowId);
+	}
+}
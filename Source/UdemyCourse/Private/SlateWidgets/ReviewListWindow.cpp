@@ -0,0 +1,314 @@
+// Copyright MODogma. All Rights Reserved.
+
+#include "SlateWidgets/ReviewListWindow.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/AppStyle.h"
+
+#define LOCTEXT_NAMESPACE "ReviewListWindow"
+
+namespace ReviewListColumns
+{
+	static const FName CheckBox(TEXT("CheckBox"));
+}
+
+void SReviewListRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
+{
+	Item = InArgs._Item;
+	OnGenerateCell = InArgs._OnGenerateCell;
+
+	SMultiColumnTableRow<FReviewListItemPtr>::Construct(FSuperRowType::FArguments(), InOwnerTable);
+}
+
+TSharedRef<SWidget> SReviewListRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	if (!OnGenerateCell.IsBound())
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	return OnGenerateCell.Execute(Item, ColumnName);
+}
+
+void SReviewListWindow::Construct(const FArguments& InArgs)
+{
+	ParentWindow = InArgs._ParentWindow;
+	AllItems.Reserve(InArgs._Rows.Num());
+
+	for (int32 Index = 0; Index < InArgs._Rows.Num(); ++Index)
+	{
+		AllItems.Add(MakeShared<FReviewListItem>(FReviewListItem{Index, InArgs._Rows[Index]}));
+	}
+
+	DisplayedItems = AllItems;
+	NumChecked = AllItems.Num();
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+		.Padding(8.f)
+		[
+			SNew(SVerticalBox)
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.Text(InArgs._Message)
+				.AutoWrapText(true)
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.f, 6.f)
+			[
+				SNew(SHorizontalBox)
+				+SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(SSearchBox)
+					.HintText(LOCTEXT("FilterHint", "Filter..."))
+					.OnTextChanged(this, &SReviewListWindow::OnFilterTextChanged)
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(6.f, 0.f, 0.f, 0.f)
+				[
+					SNew(STextBlock)
+					.Text(this, &SReviewListWindow::GetCountText)
+				]
+			]
+			// Only the visible rows get widgets, so thousands of rows lay out as fast as a few
+			+SVerticalBox::Slot()
+			.FillHeight(1.f)
+			[
+				SAssignNew(ConstructedList, SListView<FReviewListItemPtr>)
+				.ListItemsSource(&DisplayedItems)
+				.OnGenerateRow(this, &SReviewListWindow::OnGenerateRowForList)
+				.HeaderRow(ConstructHeaderRow(InArgs._ColumnLabels))
+				.SelectionMode(ESelectionMode::None)
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.f, 6.f, 0.f, 0.f)
+			[
+				SNew(SHorizontalBox)
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CheckDisplayed", "Check Listed"))
+					.ToolTipText(LOCTEXT("CheckDisplayedTooltip", "Checks every item matching the filter."))
+					.OnClicked(this, &SReviewListWindow::OnSetDisplayedChecked, true)
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.f, 0.f, 0.f, 0.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("UncheckDisplayed", "Uncheck Listed"))
+					.ToolTipText(LOCTEXT("UncheckDisplayedTooltip", "Unchecks every item matching the filter."))
+					.OnClicked(this, &SReviewListWindow::OnSetDisplayedChecked, false)
+				]
+				+SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				[
+					SNullWidget::NullWidget
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(InArgs._ConfirmText)
+					.IsEnabled(this, &SReviewListWindow::CanConfirm)
+					.OnClicked(this, &SReviewListWindow::OnConfirmClicked)
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.f, 0.f, 0.f, 0.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("Cancel", "Cancel"))
+					.OnClicked(this, &SReviewListWindow::OnCancelClicked)
+				]
+			]
+		]
+	];
+}
+
+TArray<int32> SReviewListWindow::Open(const FText& Title, const FText& Message, const FText& ConfirmText, const TArray<FText>& ColumnLabels, const TArray<TArray<FString>>& Rows)
+{
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(Title)
+		.ClientSize(FVector2D(720.f, 520.f))
+		.SupportsMinimize(false)
+		.SupportsMaximize(false);
+
+	TSharedRef<SReviewListWindow> ReviewWidget = SNew(SReviewListWindow)
+		.Message(Message)
+		.ConfirmText(ConfirmText)
+		.ColumnLabels(ColumnLabels)
+		.Rows(Rows)
+		.ParentWindow(Window);
+
+	Window->SetContent(ReviewWidget);
+	FSlateApplication::Get().AddModalWindow(Window, FSlateApplication::Get().GetActiveTopLevelWindow());
+
+	TArray<int32> ConfirmedIndices;
+
+	if (ReviewWidget->bConfirmed)
+	{
+		ConfirmedIndices.Reserve(ReviewWidget->NumChecked);
+
+		// AllItems is in row order, so the indices come out sorted
+		for (const FReviewListItemPtr& Item : ReviewWidget->AllItems)
+		{
+			if (Item->bIsChecked)
+			{
+				ConfirmedIndices.Add(Item->ItemIndex);
+			}
+		}
+	}
+
+	return ConfirmedIndices;
+}
+
+TArray<int32> SReviewListWindow::Open(const FText& Title, const FText& Message, const FText& ConfirmText, const FText& ColumnLabel, const TArray<FString>& Rows)
+{
+	TArray<TArray<FString>> SingleColumnRows;
+	SingleColumnRows.Reserve(Rows.Num());
+
+	for (const FString& Row : Rows)
+	{
+		SingleColumnRows.Add({Row});
+	}
+
+	return Open(Title, Message, ConfirmText, TArray<FText>{ColumnLabel}, SingleColumnRows);
+}
+
+TSharedRef<SHeaderRow> SReviewListWindow::ConstructHeaderRow(const TArray<FText>& ColumnLabels) const
+{
+	TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow)
+		+SHeaderRow::Column(ReviewListColumns::CheckBox)
+		.DefaultLabel(FText::GetEmpty())
+		.FixedWidth(24.f)
+		.HAlignCell(HAlign_Center)
+		.VAlignCell(VAlign_Center);
+
+	for (int32 ColumnIndex = 0; ColumnIndex < ColumnLabels.Num(); ++ColumnIndex)
+	{
+		HeaderRow->AddColumn(
+			SHeaderRow::Column(GetColumnId(ColumnIndex))
+			.DefaultLabel(ColumnLabels[ColumnIndex])
+			.FillWidth(1.f)
+			.VAlignCell(VAlign_Center)
+		);
+	}
+
+	return HeaderRow;
+}
+
+TSharedRef<ITableRow> SReviewListWindow::OnGenerateRowForList(FReviewListItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SReviewListRow, OwnerTable)
+		.Item(Item)
+		.OnGenerateCell(this, &SReviewListWindow::OnGenerateCellForList);
+}
+
+TSharedRef<SWidget> SReviewListWindow::OnGenerateCellForList(FReviewListItemPtr Item, const FName& ColumnName)
+{
+	if (ColumnName == ReviewListColumns::CheckBox)
+	{
+		return SNew(SCheckBox)
+			// Bound to the item, so a regenerated row shows the current state
+			.IsChecked(this, &SReviewListWindow::GetItemCheckState, Item)
+			.OnCheckStateChanged(this, &SReviewListWindow::OnItemCheckStateChanged, Item);
+	}
+
+	const int32 ColumnIndex = ColumnName.GetNumber() - 1;
+
+	if (!Item->Columns.IsValidIndex(ColumnIndex))
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	return SNew(STextBlock)
+		.Text(FText::FromString(Item->Columns[ColumnIndex]))
+		.ToolTipText(FText::FromString(Item->Columns[ColumnIndex]));
+}
+
+void SReviewListWindow::OnItemCheckStateChanged(ECheckBoxState NewState, FReviewListItemPtr Item)
+{
+	const bool bChecked = NewState == ECheckBoxState::Checked;
+
+	if (Item->bIsChecked != bChecked)
+	{
+		Item->bIsChecked = bChecked;
+		NumChecked += bChecked ? 1 : -1;
+	}
+}
+
+void SReviewListWindow::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	DisplayedItems.Reset();
+
+	for (const FReviewListItemPtr& Item : AllItems)
+	{
+		const bool bMatches = FilterText.IsEmpty() || Item->Columns.ContainsByPredicate([this](const FString& Column)
+		{
+			return Column.Contains(FilterText);
+		});
+
+		if (bMatches)
+		{
+			DisplayedItems.Add(Item);
+		}
+	}
+
+	ConstructedList->RequestListRefresh();
+}
+
+FReply SReviewListWindow::OnSetDisplayedChecked(bool bChecked)
+{
+	for (const FReviewListItemPtr& Item : DisplayedItems)
+	{
+		OnItemCheckStateChanged(bChecked ? ECheckBoxState::Checked : ECheckBoxState::Unchecked, Item);
+	}
+
+	return FReply::Handled();
+}
+
+FReply SReviewListWindow::OnConfirmClicked()
+{
+	bConfirmed = true;
+	CloseWindow();
+	return FReply::Handled();
+}
+
+FReply SReviewListWindow::OnCancelClicked()
+{
+	CloseWindow();
+	return FReply::Handled();
+}
+
+FText SReviewListWindow::GetCountText() const
+{
+	return FText::Format(LOCTEXT("CountText", "{0} of {1} checked, {2} listed"), NumChecked, AllItems.Num(), DisplayedItems.Num());
+}
+
+void SReviewListWindow::CloseWindow()
+{
+	if (TSharedPtr<SWindow> Window = ParentWindow.Pin())
+	{
+		Window->RequestDestroyWindow();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -4,6 +4,8 @@
 #include "DebugHeader.h"
 #include "ContentBrowserModule.h"
 #include "EditorAssetLibrary.h"
+#include "ObjectTools.h"
+#include "AssetThumbnail.h"
 #include "AssetToolsModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "SlateWidgets/AdvancedDeletionWidget.h"
@@ -14,6 +16,9 @@
 #include "Styling/AppStyle.h"
 #include "UICommands/UdemyCourseUICommands.h"
 #include "SceneOutliner/OutlinerActorLock.h"
+#include "ProcessData/AssetQuarantine.h"
+#include "SlateWidgets/ReviewListWindow.h"
+#include "Settings/UdemyCourseSettings.h"
 
 #define LOCTEXT_NAMESPACE "FUdemyCourseModule"
 
@@ -32,6 +37,8 @@ void FUdemyCourseModule::StartupModule()
 
 	InitCustomSelectionEvent();
 	InitSceneOutlinerExtension();
+
+	SettingsChangedHandle = GetMutableDefault<UUdemyCourseSettings>()->OnSettingChanged().AddRaw(this, &FUdemyCourseModule::OnSettingsChanged);
 }
 
 #pragma region SelectionLock
@@ -418,6 +425,20 @@ void FUdemyCourseModule::AddCBMenuEntry(class FMenuBuilder& MenuBuilder)
 		FSlateIcon(FUdemyCourseStyle::GetStyleSetName(), "ContentBrowser.AdvancedDeletion"), // Custom icon
 		FUIAction(FExecuteAction::CreateRaw(this, &FUdemyCourseModule::OnAdvancedDeletionButtonClicked)) // Third: Binding to execute click function
 	);
+
+	MenuBuilder.AddMenuEntry(
+		LOCTEXT("RestoreQuarantine", "Restore Quarantined Assets"),
+		LOCTEXT("RestoreQuarantineTooltip", "Moves the quarantined assets of the selected folder back to where they were."),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Refresh"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FUdemyCourseModule::OnRestoreQuarantineButtonClicked))
+	);
+
+	MenuBuilder.AddMenuEntry(
+		LOCTEXT("PurgeQuarantine", "Purge Quarantined Assets"),
+		LOCTEXT("PurgeQuarantineTooltip", "Deletes the quarantined assets of the selected folder for good."),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Delete"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FUdemyCourseModule::OnPurgeQuarantineButtonClicked))
+	);
 }
 
 /** Third: The function to execute when menu entry is clicked */
@@ -489,22 +510,48 @@ void FUdemyCourseModule::OnDeleteUnusedAssetsButtonClicked()
 		return;
 	}
 
-	FString JoinedUnreferencedAssets = FString::Join(UnreferencedAssets, TEXT("\n"));
-
-	EAppReturnType::Type ConfirmDeletion = FMessageDialog::Open(
-		EAppMsgType::YesNo,
+	// A virtualized list instead of every path joined into a message dialog, unticked assets are kept
+	const TArray<int32> ConfirmedAssets = SReviewListWindow::Open(
+		LOCTEXT("DeleteUnusedAssetsTitle", "Delete Unused Assets"),
 		FText::Format(
-			LOCTEXT("UserInputRequested", "There are {0} unreferenced asset(s) under {1}:\n{2}\nWould you like to delete them?"),
+			LOCTEXT("UserInputRequested", "There are {0} unreferenced asset(s) under {1}. Untick any asset that should be kept."),
 			UnreferencedAssets.Num(),
-			FText::FromString(SelectedPaths[0]),
-			FText::FromString(JoinedUnreferencedAssets)
-		)
+			FText::FromString(SelectedPaths[0])
+		),
+		FAssetQuarantine::IsEnabled() ? LOCTEXT("QuarantineConfirm", "Move to Quarantine") : LOCTEXT("DeleteConfirm", "Delete"),
+		LOCTEXT("AssetColumn", "Asset"),
+		UnreferencedAssets
 	);
-	// Could also use ConfirmSelected == EAppReturnType::Ok, but it appears that true captures all positive types
-	if (ConfirmDeletion) 
+
+	const bool bConfirmDeletion = !ConfirmedAssets.IsEmpty();
+
+	if (bConfirmDeletion && FAssetQuarantine::IsEnabled())
 	{
-		for (const FString& UnreferencedAsset : UnreferencedAssets)
+		TArray<FAssetData> AssetsToQuarantine;
+
+		for (const int32 AssetIndex : ConfirmedAssets)
 		{
+			AssetsToQuarantine.Add(UEditorAssetLibrary::FindAssetData(UnreferencedAssets[AssetIndex]));
+		}
+
+		// One batched move instead of a delete per asset
+		const FAssetDeletionResult QuarantineResult = FAssetQuarantine::QuarantineAssets(AssetsToQuarantine);
+
+		DebugHeader::ShowNotification(
+			FText::Format(
+				LOCTEXT("AssetsQuarantined", "Moved {0} unreferenced asset(s) to {1}"),
+				QuarantineResult.DeletedAssets.Num(),
+				FText::FromString(FAssetQuarantine::GetQuarantinePath())
+			)
+		);
+
+		OnDeleteEmptyFoldersButtonClicked();
+	}
+	else if (bConfirmDeletion)
+	{
+		for (const int32 AssetIndex : ConfirmedAssets)
+		{
+			const FString& UnreferencedAsset = UnreferencedAssets[AssetIndex];
 			UEditorAssetLibrary::DeleteAsset(UnreferencedAsset);
 			UE_LOG(LogUdemyCourse, Log, TEXT("Deleted asset: %s"), *UnreferencedAsset);
 		}
@@ -512,7 +559,7 @@ void FUdemyCourseModule::OnDeleteUnusedAssetsButtonClicked()
 		DebugHeader::ShowNotification(
 			FText::Format(
 				LOCTEXT("AssetsMissingInFolder", "Successfully deleted {0} unreferenced asset(s)!"),
-				UnreferencedAssets.Num()
+				ConfirmedAssets.Num()
 			)
 		);
 
@@ -611,30 +658,29 @@ void FUdemyCourseModule::OnDeleteEmptyFoldersButtonClicked()
 		return;
 	}
 
-	// Join the array into a single string for logging
-	FString JoinedFolders = FString::Join(FoldersToDelete, TEXT("\n"));
-
-	EAppReturnType::Type ConfirmDeletion = FMessageDialog::Open(
-		EAppMsgType::YesNo,
+	const TArray<int32> ConfirmedFolders = SReviewListWindow::Open(
+		LOCTEXT("DeleteEmptyFoldersTitle", "Delete Empty Folders"),
 		FText::Format(
-			LOCTEXT("UserInputRequested", "There are {0} empty folders under {1}:\n{2}\nWould you like to delete them?"),
+			LOCTEXT("UserInputRequested", "There are {0} empty folders under {1}. Untick any folder that should be kept."),
 			FoldersToDelete.Num(),
-			FText::FromString(SelectedPaths[0]),
-			FText::FromString(JoinedFolders)
-		)
+			FText::FromString(SelectedPaths[0])
+		),
+		LOCTEXT("DeleteConfirm", "Delete"),
+		LOCTEXT("FolderColumn", "Folder"),
+		FoldersToDelete
 	);
 
-	if (ConfirmDeletion)
+	if (!ConfirmedFolders.IsEmpty())
 	{
-		for (const FString& DeleteFolder : FoldersToDelete)
+		for (const int32 FolderIndex : ConfirmedFolders)
 		{
-			UEditorAssetLibrary::DeleteDirectory(DeleteFolder);
+			UEditorAssetLibrary::DeleteDirectory(FoldersToDelete[FolderIndex]);
 		}
 
 		DebugHeader::ShowNotification(
 			FText::Format(
 				LOCTEXT("SuccessfulDeletion", "Succesfully deleted {0} empty folder(s) under {1}"),
-				FoldersToDelete.Num(),
+				ConfirmedFolders.Num(),
 				FText::FromString(SelectedPaths[0])
 			)
 		);
@@ -649,6 +695,42 @@ void FUdemyCourseModule::OnAdvancedDeletionButtonClicked()
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvancedDeletion"));
 }
 
+void FUdemyCourseModule::OnRestoreQuarantineButtonClicked()
+{
+	if (SelectedPaths.Num() != 1)
+	{
+		DebugHeader::ShowNotification(LOCTEXT("FolderSelectionErrorMessage", "Only one selected folder is allowed at a time."), ELogVerbosity::Error);
+		return;
+	}
+
+	// Works from either side, the quarantined folder itself or the folder its assets came from
+	const FString QuarantinedFolder = FAssetQuarantine::GetQuarantinedFolder(SelectedPaths[0]);
+	const int32 NumRestoredAssets = FAssetQuarantine::RestoreFolder(QuarantinedFolder);
+
+	DebugHeader::ShowNotification(
+		FText::Format(LOCTEXT("QuarantineRestored", "Restored {0} asset(s) from {1}"), NumRestoredAssets, FText::FromString(QuarantinedFolder)),
+		NumRestoredAssets > 0 ? ELogVerbosity::Log : ELogVerbosity::Warning
+	);
+}
+
+void FUdemyCourseModule::OnPurgeQuarantineButtonClicked()
+{
+	if (SelectedPaths.Num() != 1)
+	{
+		DebugHeader::ShowNotification(LOCTEXT("FolderSelectionErrorMessage", "Only one selected folder is allowed at a time."), ELogVerbosity::Error);
+		return;
+	}
+
+	// The engine's delete dialog asks for confirmation and lists anything still referenced
+	const FString QuarantinedFolder = FAssetQuarantine::GetQuarantinedFolder(SelectedPaths[0]);
+	const int32 NumPurgedAssets = FAssetQuarantine::PurgeFolder(QuarantinedFolder);
+
+	DebugHeader::ShowNotification(
+		FText::Format(LOCTEXT("QuarantinePurged", "Purged {0} asset(s) from {1}"), NumPurgedAssets, FText::FromString(QuarantinedFolder)),
+		NumPurgedAssets > 0 ? ELogVerbosity::Log : ELogVerbosity::Warning
+	);
+}
+
 bool FUdemyCourseModule::CanExecuteDeleteUnusedAssets()
 {
 	// Disable when the Advanced Deletion tab is open
@@ -695,6 +777,7 @@ TSharedRef<SDockTab> FUdemyCourseModule::OnSpawnAdvancedDeletionTab(const FSpawn
 		SNew(SAdvancedDeletionTab) // The class name of the advanced deletion widget we've added
 		//.TestString(TEXT("Hello world")) // TestString was renamed to AssetsDataToStore in AdvancedDeletionWidget.h
 		.AssetsDataToStore(GetAssetDataInDirectory())
+		.WatchedPath(SelectedPaths[0])
 	];
 
 	// --Option B--Clearing the reference when tab is closed
@@ -724,8 +807,8 @@ TArray<TSharedPtr<FAssetData>> FUdemyCourseModule::GetAssetDataInDirectory()
 
 		const FAssetData AssetData = UEditorAssetLibrary::FindAssetData(AssetPath);
 		
-		// Validate that the asset data is valid before adding it
-		if (!AssetData.IsValid())
+		// Validate that the asset data is valid before adding it. Quarantined assets are as good as deleted
+		if (!AssetData.IsValid() || FAssetQuarantine::IsInQuarantine(AssetData.PackagePath.ToString()))
 		{
 			continue;
 		}
@@ -737,6 +820,16 @@ TArray<TSharedPtr<FAssetData>> FUdemyCourseModule::GetAssetDataInDirectory()
 	return AvailableAssetsData;
 }
 
+TSharedPtr<FAssetThumbnailPool> FUdemyCourseModule::GetThumbnailPool()
+{
+	if (!ThumbnailPool.IsValid())
+	{
+		ThumbnailPool = MakeShared<FAssetThumbnailPool>(ThumbnailPoolSize);
+	}
+
+	return ThumbnailPool;
+}
+
 void FUdemyCourseModule::OnAdvancedDeletionTabClosed(TSharedRef<SDockTab> InDockTab)
 {
 	if (ConstructedDockTab.IsValid())
@@ -755,88 +848,113 @@ bool FUdemyCourseModule::DeleteAssetFromWidget(const FAssetData& AssetData)
 {
 	if (AssetData.IsValid())
 	{
-		// Returns deletion state of the asset via DeleteAsset's bool return type
-		return UEditorAssetLibrary::DeleteAsset(AssetData.GetObjectPathString());
+		// A batch of one, so single deletes get the same reference check and reporting
+		return DeleteCheckedWidgetAssets({AssetData}).HasDeletedAny();
 	}
 
 	// Asset didn't have a chance to delete, therefore return false deletion state
 	return false;
 }
 
-bool FUdemyCourseModule::DeleteCheckedWidgetAssets(const TArray<FAssetData>& AssetsToDelete)
+FAssetDeletionResult FUdemyCourseModule::DeleteCheckedWidgetAssets(const TArray<FAssetData>& AssetsToDelete)
 {
+	FAssetDeletionResult Result;
+	TArray<FAssetData> ValidAssetsToDelete;
+	ValidAssetsToDelete.Reserve(AssetsToDelete.Num());
+
 	for (const FAssetData& AssetToDelete : AssetsToDelete)
 	{
-		// The deleted assets is greater than 0
-		if (UEditorAssetLibrary::DeleteAsset(AssetToDelete.GetObjectPathString()))
+		if (AssetToDelete.IsValid())
+		{
+			ValidAssetsToDelete.Add(AssetToDelete);
+		}
+		else
 		{
-			return true;
+			Result.FailedAssets.Add(AssetToDelete);
 		}
 	}
 
-	return false;
-}
+	if (ValidAssetsToDelete.IsEmpty())
+	{
+		return Result;
+	}
 
-void FUdemyCourseModule::GetUnusedAssetsForList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
-{
-	OutUnusedAssetsData.Empty();
-	
-	for (const TSharedPtr<FAssetData>& AssetDataSharedPtr : AssetsDataToFilter)
+	if (FAssetQuarantine::IsEnabled())
 	{
-		if (!AssetDataSharedPtr.IsValid())
+		const FAssetDeletionResult QuarantineResult = FAssetQuarantine::QuarantineAssets(ValidAssetsToDelete);
+		Result.DeletedAssets = QuarantineResult.DeletedAssets;
+		Result.FailedAssets.Append(QuarantineResult.FailedAssets);
+		return Result;
+	}
+
+	// One call for the whole batch. The delete dialog gathers the referencers of every asset in a single
+	// pass and lists the referenced ones, then the engine deletes the packages and collects garbage once
+	const int32 NumDeletedAssets = ObjectTools::DeleteAssets(ValidAssetsToDelete, true);
+
+	// DeleteAssets() only returns a count, so check the registry for which assets are actually gone
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	for (const FAssetData& AssetToDelete : ValidAssetsToDelete)
+	{
+		if (NumDeletedAssets > 0 && !AssetRegistry.GetAssetByObjectPath(AssetToDelete.GetSoftObjectPath()).IsValid())
 		{
-			continue;
+			Result.DeletedAssets.Add(AssetToDelete);
 		}
-		
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetDataSharedPtr->GetObjectPathString());
-
-		if (AssetReferencers.IsEmpty())
+		else
 		{
-			OutUnusedAssetsData.Add(AssetDataSharedPtr);
+			Result.FailedAssets.Add(AssetToDelete);
 		}
 	}
+
+	UE_LOG(LogUdemyCourse, Log, TEXT("Batched delete: %d deleted, %d failed"), Result.DeletedAssets.Num(), Result.FailedAssets.Num());
+
+	for (const FAssetData& FailedAsset : Result.FailedAssets)
+	{
+		UE_LOG(LogUdemyCourse, Warning, TEXT("Asset was not deleted: %s"), *FailedAsset.GetObjectPathString());
+	}
+
+	return Result;
 }
 
-void FUdemyCourseModule::GetDuplicateNameAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutDuplicateNameAssetsData)
+bool FUdemyCourseModule::StartAssetDeletionPipeline(const TArray<FAssetData>& AssetsToDelete, FOnAssetDeletionFinished OnFinished)
 {
-	OutDuplicateNameAssetsData.Empty();
-	TMultiMap<FString, TSharedPtr<FAssetData>> DuplicateNameAssets;
+	if (IsAssetDeletionRunning() || AssetsToDelete.IsEmpty())
+	{
+		return false;
+	}
 
-	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToFilter)
+	// A batched move is quick enough to run right away, it needs no pipeline
+	if (FAssetQuarantine::IsEnabled())
 	{
-		if (!AssetData.IsValid())
-		{
-			continue;
-		}
+		const FAssetDeletionResult QuarantineResult = FAssetQuarantine::QuarantineAssets(AssetsToDelete);
 
-		// Emplace is generally more-efficient than .Add(), although not in this case because .ToString()
-		// triggers a copy construction for the return value. 
-		// Emplace would be more-efficient if the value is directly-forwarded to the container class.
-		DuplicateNameAssets.Emplace(AssetData->AssetName.ToString(), AssetData);
-	}
+		DebugHeader::ShowNotification(
+			FText::Format(
+				LOCTEXT("CheckedAssetsQuarantined", "Moved {0} asset(s) to {1}, {2} skipped. See the output log for details."),
+				QuarantineResult.DeletedAssets.Num(),
+				FText::FromString(FAssetQuarantine::GetQuarantinePath()),
+				QuarantineResult.FailedAssets.Num()
+			),
+			QuarantineResult.FailedAssets.IsEmpty() ? ELogVerbosity::Log : ELogVerbosity::Warning
+		);
 
-	TArray<TSharedPtr<FAssetData>> OutFoundDuplicateNames;
+		OnFinished.ExecuteIfBound(QuarantineResult);
+		return true;
+	}
 
-	// Iterate over list of duplicate names only
-	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToFilter)
-	{
-		OutFoundDuplicateNames.Empty();
-		DuplicateNameAssets.MultiFind(AssetData->AssetName.ToString(), OutFoundDuplicateNames);
+	ActiveDeletionPipeline = MakeShared<FAssetDeletionPipeline>(AssetsToDelete, OnFinished);
+	ActiveDeletionPipeline->Start();
+	return true;
+}
 
-		// No duplicates exist for the asset name
-		if (OutFoundDuplicateNames.Num() <= 1)
-		{
-			continue;
-		}
+void FUdemyCourseModule::GetDuplicateNameAssets(const TArray<FDeletionListRowPtr>& AssetsDataToFilter, TArray<FDeletionListRowPtr>& OutDuplicateNameAssetsData)
+{
+	OutDuplicateNameAssetsData.Reset();
 
-		for (const TSharedPtr<FAssetData>& DuplicateNameAssetData : OutFoundDuplicateNames)
-		{
-			if (DuplicateNameAssetData.IsValid())
-			{
-				// AddUnqiue() is safer than Add() for fault protection
-				OutDuplicateNameAssetsData.AddUnique(DuplicateNameAssetData);
-			}
-		}
+	// A single pass keyed on the FName itself, no string copies and no per-asset lookups into the result
+	for (TArray<FDeletionListRowPtr>& DuplicateNameGroup : GroupDuplicateRows(AssetsDataToFilter, [](const FDeletionListRow& Row) {return Row.AssetData->AssetName;}))
+	{
+		OutDuplicateNameAssetsData.Append(MoveTemp(DuplicateNameGroup));
 	}
 }
 
@@ -855,6 +973,32 @@ TArray<AActor*> FUdemyCourseModule::GetSelectedActors()
 	return WeakEditorActorSubsystem->GetSelectedLevelActors();
 }
 
+FNamingConvention& FUdemyCourseModule::GetNamingConvention()
+{
+	if (!NamingConvention.IsValid())
+	{
+		NamingConvention = MakeUnique<FNamingConvention>(*GetDefault<UUdemyCourseSettings>());
+	}
+
+	return *NamingConvention;
+}
+
+FAssetJobScheduler& FUdemyCourseModule::GetJobScheduler()
+{
+	if (!JobScheduler.IsValid())
+	{
+		JobScheduler = MakeUnique<FAssetJobScheduler>();
+	}
+
+	return *JobScheduler;
+}
+
+void FUdemyCourseModule::OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Recompiled on the next use, any rule may have changed
+	NamingConvention.Reset();
+}
+
 #pragma endregion // ProcessData
 
 void FUdemyCourseModule::ShutdownModule()
@@ -865,6 +1009,17 @@ void FUdemyCourseModule::ShutdownModule()
 	FUdemyCourseStyle::Shutdown();
 	FUdemyCourseUICommands::Unregister();
 	UnregisterSceneOutlinerColumnExtension();
+	// Stops ticking a deletion that is still in progress
+	ActiveDeletionPipeline.Reset();
+	JobScheduler.Reset();
+	ThumbnailPool.Reset();
+	NamingConvention.Reset();
+
+	// The settings object is already gone when the module unloads during engine exit
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<UUdemyCourseSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,32 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProcessData/AssetJobScheduler.h"
+
+/** Random ranges of FRandomizeActorsTransformJob. A zero rotation or offset leaves that part of the transform alone */
+struct FActorRandomTransform
+{
+	/** Up to this much is added per axis */
+	FRotator MaxRotation = FRotator::ZeroRotator;
+	/** Up to this much is added per axis, in local space */
+	FVector MaxOffset = FVector::ZeroVector;
+	/** The relative scale is set to a random value in [ScaleMin, ScaleMax] per axis */
+	bool bRandomizeScale = false;
+	FVector ScaleMin = FVector::OneVector;
+	FVector ScaleMax = FVector::OneVector;
+};
+
+/** Bulk actor operations as jobs for FAssetJobScheduler, used by the async actions */
+namespace QuickActorJobs
+{
+	/**
+	 * Duplicates every actor NumDuplicates times, each copy OffsetDistance further than the last, with a random
+	 * rotation of up to RandomRotation per axis. The duplicates are selected once the job finishes
+	 */
+	TSharedRef<FAssetJob> MakeDuplicateActorsJob(const TArray<AActor*>& SourceActors, int32 NumDuplicates, const FVector& OffsetDistance, const FRotator& RandomRotation);
+
+	/** Randomizes the rotation, offset and scale of every actor within RandomTransform, one actor per step */
+	TSharedRef<FAssetJob> MakeRandomizeActorsTransformJob(const TArray<AActor*>& Actors, const FActorRandomTransform& RandomTransform);
+}
@@ -5,18 +5,6 @@
 #include "CoreMinimal.h"
 #include "AssetActionUtility.h"
 
-// Required for the prefix map
-#include "Materials/Material.h"
-#include "Materials/MaterialInstanceConstant.h"
-#include "Particles/ParticleSystem.h"
-#include "Sound/SoundCue.h"
-#include "Sound/SoundWave.h"
-#include "Engine/Texture.h"
-#include "Blueprint/UserWidget.h"
-#include "Components/SkeletalMeshComponent.h"
-#include "NiagaraSystem.h"
-#include "NiagaraEmitter.h"
-
 #include "QuickAssetAction.generated.h"
 
 /**
@@ -45,24 +33,14 @@ public:
 	UFUNCTION(CallInEditor, Category = "Udemy", meta = (ToolTip = "Rename assets."))
 	void RenameSelection(bool bAddPrefixes, FString NewName);
 
+	/** Checks the names of every asset under /Game from the Asset Registry, without loading any of them */
+	UFUNCTION(CallInEditor, Category = "Udemy", meta = (ToolTip = "Report every asset in the project that breaks the naming convention in the plugin settings."))
+	void ValidateNamingConvention();
+
 private:
-	TMap<UClass*, FString> PrefixMap =
-	{
-		{UBlueprint::StaticClass(), TEXT("BP_")},
-		{UStaticMesh::StaticClass(), TEXT("SM_")},
-		{UMaterial::StaticClass(), TEXT("M_")},
-		{UMaterialInstanceConstant::StaticClass(), TEXT("MI_")},
-		{UMaterialFunctionInterface::StaticClass(), TEXT("MF_")},
-		{UParticleSystem::StaticClass(), TEXT("PS_")},
-		{USoundCue::StaticClass(), TEXT("SC_")},
-		{USoundWave::StaticClass(), TEXT("SW_")},
-		{UTexture::StaticClass(), TEXT("T_")},
-		{UTexture2D::StaticClass(), TEXT("T_")},
-		{UUserWidget::StaticClass(), TEXT("WBP_")},
-		{USkeletalMeshComponent::StaticClass(), TEXT("SK_")},
-		{UNiagaraSystem::StaticClass(), TEXT("NS_")},
-		{UNiagaraEmitter::StaticClass(), TEXT("NE_")},
-		// Add more common asset classes here. Will require including their headers
-		// and modules (for classes existing in their own module)
-	};
+	/**
+	 * Resolves name conflicts, shows the before/after table for review, then renames the confirmed
+	 * items in one batch, see FAssetBatchRename. Returns the number renamed, INDEX_NONE if cancelled
+	 */
+	int32 RenameAssetsInBatch(TArray<struct FAssetBatchRenameItem> AssetsToRename);
 };
@@ -0,0 +1,25 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "ProcessData/AssetJobScheduler.h"
+
+class UQuickMaterialWidget;
+
+/** The bulk asset actions as jobs for FAssetJobScheduler, shared by UQuickAssetAction and the async actions */
+namespace QuickAssetJobs
+{
+	/** Duplicates every asset NumDuplicates times next to the original, then saves the copies */
+	TSharedRef<FAssetJob> MakeDuplicateAssetsJob(const TArray<FAssetData>& SourceAssets, int32 NumDuplicates);
+
+	/** Fixes up every redirector under /Game. Coalesces with a fixup that is still queued */
+	TSharedRef<FAssetJob> MakeFixUpRedirectorsJob();
+
+	/** Checks every asset name under /Game against the naming convention. Coalesces with a queued validation */
+	TSharedRef<FAssetJob> MakeValidateNamingConventionJob();
+
+	/** Creates one material from the textures with the settings of the material widget, see UQuickMaterialWidget */
+	TSharedRef<FAssetJob> MakeCreateMaterialJob(UQuickMaterialWidget* MaterialWidget, const TArray<FAssetData>& TexturesData);
+}
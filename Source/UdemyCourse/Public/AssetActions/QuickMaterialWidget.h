@@ -53,6 +53,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CreateMaterial", meta = (ToolTip = "Automatically saves the material after generating."))
 	bool bAutosave = false;
 
+	/**
+	 * The phases of CreateMaterialFromSelectedTextures(), so UAsyncBulkAction::CreateMaterialFromTexturesAsync()
+	 * can add one texture per editor frame. Only one material is built at a time, BeginMaterialCreation() fails
+	 * while another one is pending
+	 */
+	bool HasValidMaterialName();
+	/** Derives MaterialName from the first texture, unless bOverrideMaterialName */
+	void SetMaterialNameFromTexture(const FString& InTextureName);
+	bool BeginMaterialCreation(const FString& InPackagePath);
+	void AddTextureToMaterial(UTexture2D* InTexture);
+	/** Compiles the material, then creates the instance and saves as configured. A cancelled material is only compiled and saved */
+	void FinishMaterialCreation(bool bCancelled);
+
 #pragma endregion
 
 #pragma region SupportedTextureNames
@@ -99,6 +112,12 @@ private:
 	int32 NodeSortPriority = 0;
 	int32 NodeOffsetY = 0;
 	bool bPackedPinsConnected = false;
+	uint32 NumConnectedPins = 0;
+
+	/** Material between BeginMaterialCreation() and FinishMaterialCreation() */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterial> PendingMaterial;
+	FString PendingMaterialPath;
 	static const int32 OffsetIncrement = 300;
 
 	/** Returns true if asset data was successfully processed */
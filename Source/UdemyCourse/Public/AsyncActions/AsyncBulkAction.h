@@ -0,0 +1,84 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AssetRegistry/AssetData.h"
+
+#include "AsyncBulkAction.generated.h"
+
+class FAssetJob;
+class UQuickMaterialWidget;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAsyncBulkActionProgress, float, Progress, int32, NumStepsDone, int32, NumSteps);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAsyncBulkActionCompleted, bool, bCancelled);
+
+/**
+ * Latent versions of the plugin's bulk asset and actor operations for editor utility widgets and Python.
+ * Each one queues a job on the plugin's job scheduler and returns right away, the returned action is the
+ * handle: bind OnProgress and OnCompleted, call Cancel() to stop it. From Python, bind the delegates and
+ * call activate() on the returned action.
+ */
+UCLASS()
+class UDEMYCOURSE_API UAsyncBulkAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/** Called once per editor frame while the job runs */
+	UPROPERTY(BlueprintAssignable)
+	FAsyncBulkActionProgress OnProgress;
+
+	/** Called once the job finished or was cancelled, also when it was merged into an identical queued job */
+	UPROPERTY(BlueprintAssignable)
+	FAsyncBulkActionCompleted OnCompleted;
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Duplicate the assets a number of times without blocking the editor."))
+	static UAsyncBulkAction* DuplicateAssetsAsync(const TArray<FAssetData>& Assets, int32 NumDuplicates);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Fix up all redirectors in the project without blocking the editor."))
+	static UAsyncBulkAction* FixUpAllRedirectorsAsync();
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Check every asset name in the project against the naming convention without blocking the editor."))
+	static UAsyncBulkAction* ValidateNamingConventionAsync();
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Duplicate the actors with an offset and random rotation without blocking the editor."))
+	static UAsyncBulkAction* DuplicateActorsAsync(const TArray<AActor*>& Actors, int32 NumDuplicates, FVector OffsetDistance, FRotator RandomRotation);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Add a random rotation of up to RandomRotation per axis to the actors without blocking the editor."))
+	static UAsyncBulkAction* RandomizeActorsRotationAsync(const TArray<AActor*>& Actors, FRotator RandomRotation);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Add a random offset of up to OffsetDistance per axis to the actors without blocking the editor."))
+	static UAsyncBulkAction* RandomizeActorsOffsetAsync(const TArray<AActor*>& Actors, FVector OffsetDistance);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Set the actors to a random scale between ScaleMin and ScaleMax per axis without blocking the editor."))
+	static UAsyncBulkAction* RandomizeActorsScaleAsync(const TArray<AActor*>& Actors, FVector ScaleMin, FVector ScaleMax);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Randomize the rotation, offset and scale of the actors without blocking the editor."))
+	static UAsyncBulkAction* RandomizeActorsTransformAsync(const TArray<AActor*>& Actors, FVector OffsetDistance, FRotator RandomRotation, FVector ScaleMin, FVector ScaleMax);
+
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Create a material from the textures with the settings of the material widget, one texture per frame."))
+	static UAsyncBulkAction* CreateMaterialFromTexturesAsync(UQuickMaterialWidget* MaterialWidget, const TArray<FAssetData>& Textures);
+
+	/**
+	 * Stops the job after its current step, or takes it off the queue if it hasn't started.
+	 * When merged into an identical queued job, only this action stops waiting for it. OnCompleted fires either way
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Udemy|Async")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "Udemy|Async")
+	bool IsRunning() const {return bIsRunning;}
+
+	virtual void Activate() override;
+
+private:
+	static UAsyncBulkAction* Create(const TSharedRef<FAssetJob>& InJob);
+
+	void OnJobProgress(int32 NumStepsDone, int32 NumSteps);
+	void OnJobFinished(bool bCancelled);
+
+	TSharedPtr<FAssetJob> Job;
+	bool bIsRunning = false;
+};
@@ -120,6 +120,54 @@ namespace DebugHeader
 		// End Method B
 	}
 
+	/** 
+	 * Progress notification that stays open until completed with FinishPendingNotification().
+	 * The cancel button is only added when OnCancelClicked is bound
+	 */
+	static TSharedPtr<SNotificationItem> ShowPendingNotification(FText Message, FSimpleDelegate OnCancelClicked = FSimpleDelegate())
+	{
+		FNotificationInfo Info(Message);
+		Info.bFireAndForget = false;
+		Info.bUseThrobber = true;
+		Info.bUseSuccessFailIcons = true;
+		Info.ExpireDuration = 3.f;
+
+		if (OnCancelClicked.IsBound())
+		{
+			Info.ButtonDetails.Add(FNotificationButtonInfo(
+				LOCTEXT("PendingNotificationCancel", "Cancel"),
+				LOCTEXT("PendingNotificationCancelTooltip", "Cancels the task after the current batch."),
+				OnCancelClicked,
+				SNotificationItem::CS_Pending
+			));
+		}
+
+		TSharedPtr<SNotificationItem> NotificationPtr = FSlateNotificationManager::Get().AddNotification(Info);
+
+		if (NotificationPtr.IsValid())
+		{
+			NotificationPtr->SetCompletionState(SNotificationItem::CS_Pending);
+		}
+
+		UE_LOG(LogUdemyCourse, Log, TEXT("%s"), *Message.ToString());
+		return NotificationPtr;
+	}
+
+	/** Sets the final text and state of a pending notification, then fades it out */
+	static void FinishPendingNotification(const TSharedPtr<SNotificationItem>& NotificationPtr, FText Message, bool bSucceeded)
+	{
+		UE_LOG(LogUdemyCourse, Log, TEXT("%s"), *Message.ToString());
+
+		if (!NotificationPtr.IsValid())
+		{
+			return;
+		}
+
+		NotificationPtr->SetText(Message);
+		NotificationPtr->SetCompletionState(bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		NotificationPtr->ExpireAndFadeout();
+	}
+
 	// Using FMessageDialog::Open() is better than this anyway, as it has proper optional return
 	// value and many overload options for flexibility and min inputs
 	/** Display a message dialog and handle the return condition from user input.
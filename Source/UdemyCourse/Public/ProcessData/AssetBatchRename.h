@@ -0,0 +1,44 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** One asset of a batch rename, its new package path and asset name */
+struct FAssetBatchRenameItem
+{
+	FAssetData AssetData;
+	FString NewPackagePath;
+	FString NewName;
+};
+
+/**
+ * Renames and moves assets as a single batch. Every asset goes through one IAssetTools::RenameAssets()
+ * call, so referencing packages are loaded and resaved once for the whole batch instead of once per
+ * asset, and the redirectors it leaves behind are fixed up and deleted in one pass.
+ * Batches larger than the configured window size are split, see FAssetWindowedExecutor. Each window
+ * is then saved before it is unloaded, a renamed package is dirty and would otherwise stay loaded.
+ */
+class FAssetBatchRename
+{
+public:
+	/**
+	 * Dry run of the batch against a name index of every destination folder, nothing is renamed.
+	 * Items whose name is already taken, by an asset, a redirector or an earlier item, get the next free
+	 * trailing number instead, e.g. SM_Crate_3 becomes SM_Crate_4. Items in the same order always
+	 * resolve the same way. Items that keep their current path are dropped. OutRequestedNames gets the
+	 * name each item asked for, in the resulting order. Returns the number of renamed items
+	 */
+	static int32 ResolveNameConflicts(TArray<FAssetBatchRenameItem>& Items, TArray<FString>& OutRequestedNames);
+
+	/** Returns the original data of the assets that arrived at their new path */
+	static TArray<FAssetData> RenameAssets(const TArray<FAssetBatchRenameItem>& Items, const FText& ProgressMessage);
+
+private:
+	/**
+	 * Loads, renames and fixes up one window, saving the renamed packages it loaded if bSaveRenamedPackages.
+	 * Returns false if the loading was cancelled
+	 */
+	static bool RenameWindow(TArrayView<const FAssetBatchRenameItem> Items, bool bSaveRenamedPackages, TArray<FAssetData>& OutRenamedAssets, TArray<UPackage*>& OutPackagesToRelease);
+};
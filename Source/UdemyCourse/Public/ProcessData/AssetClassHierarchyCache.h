@@ -0,0 +1,21 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Ancestors of asset classes from the class path in their FAssetData, so no asset is loaded.
+ * Hierarchies come from the asset registry, which knows Blueprint classes as well, and are
+ * memoized per class, a batch only walks each distinct class once.
+ */
+class FAssetClassHierarchyCache
+{
+public:
+	/** The class followed by its ancestors, closest first */
+	const TArray<FTopLevelAssetPath>& GetClassHierarchy(const FTopLevelAssetPath& ClassPath);
+
+private:
+	TMap<FTopLevelAssetPath, TArray<FTopLevelAssetPath>> ClassHierarchies;
+};
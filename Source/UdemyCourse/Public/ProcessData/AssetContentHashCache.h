@@ -0,0 +1,56 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 128-bit MD5 of a package payload. Zero means the package couldn't be hashed */
+struct FAssetContentHash
+{
+	uint64 High = 0;
+	uint64 Low = 0;
+
+	bool IsValid() const {return High != 0 || Low != 0;}
+	bool operator==(const FAssetContentHash& Other) const {return High == Other.High && Low == Other.Low;}
+
+	friend uint32 GetTypeHash(const FAssetContentHash& Hash)
+	{
+		return HashCombine(GetTypeHash(Hash.High), GetTypeHash(Hash.Low));
+	}
+};
+
+/**
+ * Payload hashes of package files, shared by every duplicate content query of the editor session.
+ * An entry is reused as long as the file timestamp and size are unchanged, so repeat queries only
+ * hash the packages that were saved in between. Game thread only, hashing itself runs on worker threads.
+ */
+class FAssetContentHashCache
+{
+public:
+	/**
+	 * Returns one hash per package name, in the same order. Stale or missing entries are hashed
+	 * in parallel, with a cancellable progress dialog. Cancelled or unreadable packages get an invalid hash,
+	 * bOutCancelled tells the two apart
+	 */
+	TArray<FAssetContentHash> GetHashes(const TArray<FName>& PackageNames, bool* bOutCancelled = nullptr);
+
+	/**
+	 * Hashes everything after the package header, plus the .uexp file when exports are split off, together with
+	 * the names and import paths the payload indices resolve to. The raw header is left out, it holds the package
+	 * name and guids, which always differ between two copies of an asset
+	 */
+	static FAssetContentHash HashPackagePayload(const FString& Filename, FName PackageName);
+
+private:
+	struct FCacheEntry
+	{
+		FDateTime Timestamp;
+		int64 FileSize = INDEX_NONE;
+		FAssetContentHash Hash;
+	};
+
+	/** Packages hashed per parallel batch, progress and cancellation are checked in between */
+	static constexpr int32 HashBatchSize = 64;
+
+	TMap<FName, FCacheEntry> Entries;
+};
@@ -0,0 +1,131 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+
+class SNotificationItem;
+
+/** Outcome of a batched delete, each requested asset ends up in exactly one of the two arrays */
+struct FAssetDeletionResult
+{
+	TArray<FAssetData> DeletedAssets;
+	TArray<FAssetData> FailedAssets;
+	/** Set when the user cancelled before every asset was processed */
+	bool bCancelled = false;
+
+	bool HasDeletedAny() const {return !DeletedAssets.IsEmpty();}
+};
+
+DECLARE_DELEGATE_OneParam(FOnAssetDeletionFinished, const FAssetDeletionResult&);
+
+/**
+ * Deletes assets in stages, time-sliced over editor frames so the rest of the editor stays usable.
+ * Validate -> Load -> Unload -> Delete files -> Update registry. Progress of the current stage is shown in a
+ * pending notification, which has a cancel button that is honoured between batches until the Unload stage is
+ * done. Assets unloaded by then are always taken through the remaining stages, so none is left half deleted.
+ */
+class FAssetDeletionPipeline : public TSharedFromThis<FAssetDeletionPipeline>
+{
+public:
+	enum class EStage : uint8
+	{
+		Validate,
+		Load,
+		Unload,
+		DeleteFiles,
+		UpdateRegistry,
+		Finished
+	};
+
+	FAssetDeletionPipeline(const TArray<FAssetData>& InAssetsToDelete, FOnAssetDeletionFinished InOnFinished);
+	~FAssetDeletionPipeline();
+
+	/** Registers the ticker and shows the progress notification */
+	void Start();
+	/** Stops after the current batch. Assets unloaded so far are still deleted */
+	void Cancel();
+
+	bool IsRunning() const {return Stage != EStage::Finished;}
+
+private:
+	/** One asset moving through the stages */
+	struct FPendingAsset
+	{
+		FAssetData AssetData;
+		/** Registry referencers gathered by the validate stage, used to order the deletes */
+		TArray<FName> Referencers;
+		/** Package file, found by the validate stage */
+		FString Filename;
+		/** Assets of one reference cycle share a group and are always in the same batch */
+		int32 GroupIndex = INDEX_NONE;
+		/** Set by the load stage */
+		TWeakObjectPtr<UObject> Asset;
+	};
+
+	bool Tick(float DeltaTime);
+	/** Processes up to BatchSize items of the current stage, returns true once the stage is done */
+	bool ProcessBatch();
+	bool ValidateBatch();
+	bool LoadBatch();
+	bool UnloadBatch();
+	bool DeleteFilesBatch();
+	bool UpdateRegistryBatch();
+
+	/** Fails assets referenced from outside the pending set until nothing changes, since each failure keeps its referencees alive */
+	void FailExternallyReferencedAssets();
+	/** Orders StageOutput so every asset comes after the pending assets referencing it, and groups reference cycles */
+	void SortReferencersFirst();
+	/** End of the batch starting at BatchStart in StageInput. Only a cycle larger than BatchSize makes a larger batch */
+	int32 GetBatchEnd(int32 BatchStart) const;
+	/** Returns the first referencer that is neither deleted nor pending, the asset has to stay while it exists */
+	const FName* FindKeptReferencer(const TArray<FName>& Referencers) const;
+
+	void EnterStage(EStage NewStage);
+	/** Fails what the current stage hasn't processed yet */
+	void CancelRemainingAssets();
+	void Fail(const FAssetData& AssetData, const TCHAR* Reason);
+	/** Fails an asset that is unloaded already, its file is scanned back into the registry by the last stage */
+	void Restore(const FPendingAsset& PendingAsset, const TCHAR* Reason);
+	void Finish();
+	void UpdateNotification();
+	static FText GetStageText(EStage InStage);
+
+	/** Items handled per batch, cancellation and the frame budget are checked in between */
+	static constexpr int32 BatchSize = 32;
+	/** Work done per editor frame before yielding back */
+	static constexpr double FrameBudgetSeconds = 0.008;
+	/** Async package loads requested at once by the load stage */
+	static constexpr int32 MaxLoadsInFlight = 64;
+
+	TArray<FPendingAsset> StageInput;
+	TArray<FPendingAsset> StageOutput;
+	/** Position in StageInput of the next item to process */
+	int32 StageCursor = 0;
+	EStage Stage = EStage::Validate;
+	/** End of the current frame's budget, the load stage waits for loads until then */
+	double FrameDeadline = 0.0;
+
+	/** Indices into StageInput of the finished loads, shared with the load callbacks that may outlive a cancel */
+	TSharedRef<TArray<int32>> CompletedLoads = MakeShared<TArray<int32>>();
+	int32 NumLoaded = 0;
+	/** Files of assets that were unloaded but not deleted */
+	TArray<FString> FilesToRescan;
+
+	/** Packages of the request that are neither deleted nor failed yet, referencers in here don't block deletion */
+	TSet<FName> PendingPackages;
+	/** Packages unloaded so far, their files are deleted by the later stages */
+	TSet<FName> DeletedPackages;
+	/** Number of requested assets per package, a package with other assets in it is never deleted */
+	TMap<FName, int32> NumRequestedByPackage;
+
+	int32 NumRequested = 0;
+	bool bCancelRequested = false;
+	FAssetDeletionResult Result;
+	FOnAssetDeletionFinished OnFinished;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	TSharedPtr<SNotificationItem> ProgressNotification;
+};
@@ -0,0 +1,111 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class SNotificationItem;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAssetJobProgress, int32 /*NumStepsDone*/, int32 /*NumSteps*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetJobFinished, bool /*bCancelled*/);
+
+/**
+ * A long-running operation split into steps, run by FAssetJobScheduler.
+ * Each step should only do a small, bounded amount of work, e.g. one asset.
+ */
+class FAssetJob
+{
+public:
+	/** Jobs with the same coalesce key do the same work, NAME_None never coalesces */
+	FAssetJob(const FText& InDescription, FName InCoalesceKey = NAME_None)
+		: Description(InDescription)
+		, CoalesceKey(InCoalesceKey)
+	{}
+
+	virtual ~FAssetJob() = default;
+
+	/** Called once the job reaches the front of the queue, gathers its input and returns the number of steps */
+	virtual int32 Start() = 0;
+	virtual void ProcessStep(int32 StepIndex) = 0;
+	/** Called after the last step, or after the step that was running when the job got cancelled */
+	virtual void Finish(bool bCancelled) {}
+
+	/**
+	 * Merges a job with the same coalesce key into this one while this one hasn't started yet.
+	 * Returns false to queue both. By default the other job is simply dropped, it would repeat this one
+	 */
+	virtual bool Coalesce(const FAssetJob& Other) {return true;}
+
+	const FText& GetDescription() const {return Description;}
+	FName GetCoalesceKey() const {return CoalesceKey;}
+
+	/** Broadcast once per frame while the job runs */
+	FOnAssetJobProgress& OnProgress() {return ProgressDelegate;}
+	/** Broadcast after Finish(), or when the job is cancelled before it started */
+	FOnAssetJobFinished& OnFinished() {return FinishedDelegate;}
+
+private:
+	FOnAssetJobProgress ProgressDelegate;
+	FOnAssetJobFinished FinishedDelegate;
+	FText Description;
+	FName CoalesceKey;
+};
+
+/**
+ * Plugin-wide queue of asset jobs, run one after another and time-sliced over editor frames within the
+ * frame budget of the plugin settings, so the editor stays usable meanwhile. The running job shows a
+ * progress notification whose cancel button stops it after the current step. Game thread only.
+ */
+class FAssetJobScheduler
+{
+public:
+	/** Jobs still queued or running are reported as cancelled, without running Finish() */
+	~FAssetJobScheduler();
+
+	/**
+	 * Queues the job, returns false if it was coalesced into a job that is already queued.
+	 * A coalesced job still gets the progress and finished broadcasts of the job it was merged into
+	 */
+	bool Enqueue(const TSharedRef<FAssetJob>& Job);
+
+	/**
+	 * Cancels the job if it is running, or removes it from the queue if it hasn't started yet.
+	 * A coalesced job is detached from the job it was merged into, which keeps running for its other listeners
+	 */
+	void Cancel(const TSharedRef<FAssetJob>& Job);
+
+	/** Stops the running job after its current step, the queued jobs still run */
+	void CancelCurrent();
+	/** Drops every queued job without starting it and cancels the running one */
+	void CancelAll();
+
+	bool IsBusy() const {return CurrentJob.IsValid() || !PendingJobs.IsEmpty();}
+
+private:
+	/** A job coalesced into a queued one, together with the delegates forwarding the broadcasts to it */
+	struct FMergedJob
+	{
+		TSharedRef<FAssetJob> Job;
+		TSharedRef<FAssetJob> IntoJob;
+		FDelegateHandle ProgressHandle;
+		FDelegateHandle FinishedHandle;
+	};
+
+	bool Tick(float DeltaTime);
+	/** Returns false if the queue is empty */
+	bool StartNextJob();
+	void FinishCurrentJob(bool bCancelled);
+	void UpdateNotification();
+
+	TArray<TSharedRef<FAssetJob>> PendingJobs;
+	/** Removed once the job they were merged into finishes, or when they are cancelled on their own */
+	TArray<FMergedJob> MergedJobs;
+	TSharedPtr<FAssetJob> CurrentJob;
+	int32 NumSteps = 0;
+	int32 NextStep = 0;
+	bool bCancelRequested = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	TSharedPtr<SNotificationItem> ProgressNotification;
+};
@@ -0,0 +1,25 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Loads a selection of assets through the async loader instead of one blocking load after another.
+ * Every package is requested up front, so disk reads overlap with each other and with the per-asset work.
+ */
+class FAssetPreloader
+{
+public:
+	/**
+	 * Calls ProcessAsset on the game thread for every asset as soon as it is loaded, assets that are already
+	 * loaded first, the rest in completion order. Asset is null if it couldn't be loaded. Blocks behind a
+	 * cancellable progress dialog until every asset was processed, returns false if it was cancelled
+	 */
+	static bool LoadAndProcess(const TArray<FAssetData>& Assets, TFunctionRef<void(int32 AssetIndex, UObject* Asset)> ProcessAsset, const FText& ProgressMessage);
+
+private:
+	/** Async loading done per wait, the dialog is updated in between */
+	static constexpr float LoadingTimeSliceSeconds = 0.01f;
+};
@@ -0,0 +1,46 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "ProcessData/AssetDeletionPipeline.h"
+
+/**
+ * Move-then-purge alternative to deleting assets, enabled in the plugin settings.
+ * Quarantined assets keep their folder structure below the quarantine folder, e.g. /Game/Props/SM_Crate
+ * moves to /Game/_Quarantine/Game/Props/SM_Crate, so restoring is a move back to the stripped path.
+ * Every operation is one batched rename or delete followed by a single redirector fixup.
+ */
+class FAssetQuarantine
+{
+public:
+	/** True when the deletion paths should quarantine instead of delete */
+	static bool IsEnabled();
+	static FString GetQuarantinePath();
+	static bool IsInQuarantine(const FString& PackagePath);
+
+	/**
+	 * Folder holding the quarantined assets of a content folder. Folders already inside
+	 * the quarantine are returned as they are
+	 */
+	static FString GetQuarantinedFolder(const FString& ContentPath);
+
+	/**
+	 * Moves the assets into the quarantine. Assets referenced from outside the batch are skipped,
+	 * the same as a delete would. Moved assets count as deleted in the result
+	 */
+	static FAssetDeletionResult QuarantineAssets(const TArray<FAssetData>& AssetsToQuarantine);
+
+	/** Moves every quarantined asset below the folder back to where it came from, returns the number restored */
+	static int32 RestoreFolder(const FString& QuarantinedFolder);
+
+	/** Deletes every quarantined asset below the folder in a single delete, returns the number deleted */
+	static int32 PurgeFolder(const FString& QuarantinedFolder);
+
+private:
+	static TArray<FAssetData> GetAssetsInFolder(const FString& Folder);
+
+	/** Moves the assets as one batch, see FAssetBatchRename. Returns the original data of the assets that arrived */
+	static TArray<FAssetData> MoveAssets(const TArray<FAssetData>& AssetsToMove, TFunctionRef<FString(const FAssetData&)> GetNewPackagePath);
+};
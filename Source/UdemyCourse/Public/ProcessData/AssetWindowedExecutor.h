@@ -0,0 +1,28 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runs a bulk operation over a large selection in consecutive windows of the size set in the plugin
+ * settings. After each window the packages it is done with are unloaded and garbage is collected, so
+ * only one window of assets is resident at a time and peak memory doesn't grow with the selection.
+ * Selections that fit in a single window run as one window, without any unloading.
+ */
+class FAssetWindowedExecutor
+{
+public:
+	/**
+	 * Calls ProcessWindow for each window of NumItems, in order. ProcessWindow adds the packages it
+	 * loaded to OutPackagesToRelease and returns false to stop. Cancellable between windows,
+	 * returns false if stopped or cancelled before the last window
+	 */
+	static bool ForEachWindow(int32 NumItems, TFunctionRef<bool(int32 WindowStart, int32 WindowCount, TArray<UPackage*>& OutPackagesToRelease)> ProcessWindow, const FText& ProgressMessage);
+
+	/** Items per window from the plugin settings, NumItems when windowing is disabled */
+	static int32 GetWindowSize(int32 NumItems);
+
+	/** Unloads the packages without unsaved changes, then collects garbage. Dirty packages stay loaded */
+	static void ReleasePackages(const TArray<UPackage*>& Packages);
+};
@@ -0,0 +1,49 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+
+class FArchive;
+
+/**
+ * Writes rows of the advanced deletion list to a CSV or JSON file for review outside the editor.
+ * Rows are encoded to UTF-8 one at a time into a fixed size buffer that is flushed to the file
+ * whenever it fills up, so memory use doesn't grow with the number of rows.
+ */
+class FDeletionListExporter
+{
+public:
+	enum class EFormat : uint8
+	{
+		Csv,
+		Json
+	};
+
+	/** Picks the format from the file extension, anything but .json is written as CSV */
+	static EFormat GetFormatForFilename(const FString& Filename);
+
+	/** Writes the rows in the given order, returns false if the file couldn't be written */
+	static bool ExportRows(const TArray<FDeletionListRowPtr>& Rows, const FString& Filename, EFormat Format);
+
+private:
+	explicit FDeletionListExporter(FArchive& InWriter);
+
+	void WriteCsvRow(const FDeletionListRow& Row);
+	void WriteJsonRow(const FDeletionListRow& Row, bool bIsFirst);
+
+	/** Appends the text as UTF-8, flushing the buffer first if it would overflow */
+	void Append(FStringView Text);
+	void AppendCsvField(FStringView Field);
+	void AppendJsonString(FStringView Value);
+	void Flush();
+
+	/** Bytes buffered before a write to the file */
+	static constexpr int32 BufferSize = 64 * 1024;
+
+	FArchive& Writer;
+	TArray<UTF8CHAR> Buffer;
+	/** Reused for every number and escaped value, so rows don't allocate */
+	TStringBuilder<256> Scratch;
+};
@@ -0,0 +1,88 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "ProcessData/AssetClassHierarchyCache.h"
+
+class UUdemyCourseSettings;
+
+enum class ENamingIssue : uint8
+{
+	None = 0,
+	MissingPrefix = 1 << 0,
+	MissingSuffix = 1 << 1,
+	InvalidCharacters = 1 << 2,
+};
+
+ENUM_CLASS_FLAGS(ENamingIssue);
+
+/**
+ * The studio naming convention from the plugin settings, compiled once into lookup tables.
+ * Class rules resolve through the class hierarchy and folder rules through the package path, both
+ * memoized per distinct class and folder, and allowed characters become an ASCII bit mask.
+ * Checking a name then costs a few map lookups and one pass over its characters. Game thread only.
+ */
+class FNamingConvention
+{
+public:
+	explicit FNamingConvention(const UUdemyCourseSettings& Settings);
+
+	/** False if neither a class nor a folder rule applies, such assets are never renamed or reported */
+	bool HasRule(const FAssetData& AssetData);
+
+	ENamingIssue Validate(const FAssetData& AssetData);
+
+	/**
+	 * BaseName with the stripped affixes of the class rule removed, invalid characters replaced
+	 * and the required prefix and suffix added. Affixes already present aren't added twice
+	 */
+	FString MakeConformingName(const FAssetData& AssetData, const FString& BaseName);
+
+	/** Short description of the issues for logs, e.g. "missing prefix T_" */
+	FString DescribeIssues(const FAssetData& AssetData, ENamingIssue Issues);
+
+private:
+	struct FCompiledClassRule
+	{
+		FString Prefix;
+		FString Suffix;
+		TArray<FString> StripPrefixes;
+		TArray<FString> StripSuffixes;
+	};
+
+	struct FCompiledFolderRule
+	{
+		FString Prefix;
+		FString Suffix;
+	};
+
+	/** Class and folder rule merged for one asset, pointers into the compiled rules */
+	struct FEffectiveRule
+	{
+		const FCompiledClassRule* ClassRule = nullptr;
+		const FString* Prefix = nullptr;
+		const FString* Suffix = nullptr;
+	};
+
+	FEffectiveRule FindRule(const FAssetData& AssetData);
+	int32 FindClassRuleIndex(const FTopLevelAssetPath& ClassPath);
+	int32 FindFolderRuleIndex(FName PackagePath);
+	bool IsAllowedCharacter(TCHAR Character) const;
+
+	TArray<FCompiledClassRule> ClassRules;
+	TMap<FTopLevelAssetPath, int32> ClassRuleIndices;
+	TArray<FCompiledFolderRule> FolderRules;
+	/** Folder rule per configured folder, matched against the package path and each of its parents */
+	TMap<FName, int32> FolderRuleIndices;
+
+	/** Memoized lookups, INDEX_NONE when no rule applies */
+	TMap<FTopLevelAssetPath, int32> ResolvedClassRules;
+	TMap<FName, int32> ResolvedFolderRules;
+	FAssetClassHierarchyCache ClassHierarchy;
+
+	/** One bit per ASCII character, names with anything above 127 are always reported */
+	uint64 AllowedCharacterMask[2] = {0, 0};
+	static const FString EmptyAffix;
+};
@@ -0,0 +1,51 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UTexture;
+
+/**
+ * 64-bit difference hashes (dHash) of texture source art. The hash only depends on the coarse
+ * brightness gradients of the image, so the same texture re-imported at another resolution or
+ * compression ends up within a few bits of the original.
+ * Hashes are cached per source GUID for the editor session. Game thread only.
+ */
+class FTexturePerceptualHashCache
+{
+public:
+	/**
+	 * Returns one hash per asset, in the same order. Textures are loaded when neither the package
+	 * nor the source GUID is cached, asynchronously and in windows behind a cancellable progress dialog,
+	 * and unloaded again once hashed. Non-textures, cancelled or unreadable assets get an unset value,
+	 * bOutCancelled tells the cancelled ones apart
+	 */
+	TArray<TOptional<uint64>> GetHashes(const TArray<FAssetData>& Assets, bool* bOutCancelled = nullptr);
+
+	/**
+	 * Clusters hashes within MaxDistance bits of each other, transitively. Writes a cluster id per
+	 * hash, INDEX_NONE for hashes without any near neighbour. Candidates are found through 8-bit bands,
+	 * so pairs are only compared when they share a band instead of every hash against every other
+	 */
+	static void FindClusters(const TArray<uint64>& Hashes, TArray<int32>& OutClusterIds, int32 MaxDistance = DefaultMaxDistance);
+
+	/** Two hashes sharing no 8-bit band differ in at least 8 bits, so any distance below that is found */
+	static constexpr int32 DefaultMaxDistance = 6;
+
+private:
+	/** Source GUID of a package, reused while the package file is unchanged so the texture isn't loaded again */
+	struct FPackageSourceId
+	{
+		FDateTime Timestamp;
+		FGuid SourceId;
+	};
+
+	/** Caches the source GUID of the texture's package and returns the hash of that source, computing it if needed */
+	TOptional<uint64> HashTexture(UTexture* Texture, const FDateTime& PackageTimestamp);
+	static bool ComputeHash(UTexture* Texture, uint64& OutHash);
+
+	TMap<FGuid, uint64> HashesBySourceId;
+	TMap<FName, FPackageSourceId> SourceIdsByPackage;
+};
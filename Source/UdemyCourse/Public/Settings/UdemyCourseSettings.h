@@ -0,0 +1,97 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "UdemyCourseSettings.generated.h"
+
+/** Naming rule of an asset class, subclasses without a rule of their own use it as well */
+USTRUCT()
+struct FAssetNamingClassRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Naming", meta = (AllowAbstract))
+	FSoftClassPath AssetClass;
+
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	FString Prefix;
+
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	FString Suffix;
+
+	/** Removed from a name before the rule's prefix is added, e.g. the engine's default M_ on material instances */
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	TArray<FString> StripPrefixes;
+
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	TArray<FString> StripSuffixes;
+};
+
+/** Overrides the class rules for every asset below a folder, the deepest matching folder wins */
+USTRUCT()
+struct FAssetNamingFolderRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Naming", meta = (ContentDir, LongPackageName))
+	FDirectoryPath Folder;
+
+	/** Replaces the class prefix when set */
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	FString Prefix;
+
+	/** Replaces the class suffix when set */
+	UPROPERTY(EditAnywhere, Category = "Naming")
+	FString Suffix;
+};
+
+/**
+ * Project settings of the plugin, found under Editor > Plugins > MODify.
+ * Stored in DefaultEditor.ini so the whole team shares them.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "MODify"))
+class UDEMYCOURSE_API UUdemyCourseSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UUdemyCourseSettings();
+
+	virtual FName GetContainerName() const override {return FName(TEXT("Editor"));}
+	virtual FName GetCategoryName() const override {return FName(TEXT("Plugins"));}
+
+	/** Deletion paths move assets into the quarantine folder instead, purge it once the move is confirmed safe */
+	UPROPERTY(config, EditAnywhere, Category = "Quarantine", meta = (ToolTip = "Move assets into the quarantine folder instead of deleting them. Restoring is then a move back, not a re-import."))
+	bool bQuarantineInsteadOfDelete = false;
+
+	UPROPERTY(config, EditAnywhere, Category = "Quarantine", meta = (ContentDir, LongPackageName, EditCondition = "bQuarantineInsteadOfDelete"))
+	FDirectoryPath QuarantinePath;
+
+	/** Selecting more rows than this in the Advanced Deletion list doesn't sync the Content Browser, 0 always syncs */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced Deletion", meta = (ClampMin = "0", ToolTip = "Largest list selection that is still synced to the Content Browser. 0 syncs any selection."))
+	int32 MaxContentBrowserSyncSelection = 500;
+
+	/** Time the queued asset jobs may take per editor frame, at least one step runs every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Jobs", meta = (ClampMin = "1", UIMin = "1", UIMax = "50", Units = "ms", ToolTip = "Time per editor frame spent on queued bulk operations. Higher finishes sooner, lower keeps the editor smoother."))
+	float JobFrameBudgetMs = 8.f;
+
+	/** Bulk operations over more assets than this run in windows, with the loaded packages released in between. 0 disables windowing */
+	UPROPERTY(config, EditAnywhere, Category = "Jobs", meta = (ClampMin = "0", ToolTip = "Assets processed per window by bulk operations. Memory is released between windows, so peak memory stays flat on huge selections. 0 processes everything at once."))
+	int32 AssetWindowSize = 500;
+
+	UPROPERTY(config, EditAnywhere, Category = "Naming Convention")
+	TArray<FAssetNamingClassRule> ClassRules;
+
+	UPROPERTY(config, EditAnywhere, Category = "Naming Convention")
+	TArray<FAssetNamingFolderRule> FolderRules;
+
+	/** Characters allowed in asset names, with ranges written as a-z. Other characters are replaced by underscores */
+	UPROPERTY(config, EditAnywhere, Category = "Naming Convention")
+	FString AllowedCharacters = TEXT("A-Za-z0-9_");
+
+	/** Quarantine folder as a package path without a trailing slash, falls back to the default when left empty */
+	FString GetQuarantinePath() const;
+};
@@ -0,0 +1,236 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+#include "ProcessData/AssetContentHashCache.h"
+
+/**
+ * A stackable condition of the advanced deletion list.
+ * Results are memoized as one bit per RowId, and only recomputed after the filter is marked dirty.
+ */
+class FDeletionListFilter
+{
+public:
+	virtual ~FDeletionListFilter() = default;
+
+	virtual FText GetDisplayName() const = 0;
+
+	bool IsEnabled() const {return bEnabled;}
+	/** Toggling keeps the memoized results, so re-enabling a filter is free unless they are outdated */
+	void SetEnabled(bool bInEnabled) {bEnabled = bInEnabled;}
+	/** Invalidates the memoized results, e.g. after a parameter of the filter changed */
+	void MarkDirty() {bDirty = true;}
+
+	/**
+	 * Returns the pass bits for every RowId below NumRowIds. A clean filter only evaluates rows added
+	 * since its last evaluation, unless it depends on the whole row set (see DependsOnRowSet()).
+	 */
+	const TBitArray<>& Evaluate(const TArray<FDeletionListRowPtr>& Rows, int32 NumRowIds);
+
+	/** True when adding or removing any row can change the result of the other rows, e.g. duplicates */
+	virtual bool DependsOnRowSet() const {return false;}
+
+	/** True when the memoized results expired on their own, e.g. because they depend on the current date */
+	virtual bool IsOutdated() const {return false;}
+
+	/** True when saving a listed package can change the result, e.g. content hashes */
+	virtual bool DependsOnPackageContent() const {return false;}
+
+	/** Filters matching rows against each other can show their results grouped, see GroupRows() */
+	virtual bool CanGroupRows() const {return false;}
+	/** Adds one group header per group of FilteredRows, keeping the order of the rows */
+	virtual void GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const {}
+
+protected:
+	/** Per-row predicate. Set-based filters override EvaluateRowSet() instead */
+	virtual bool PassesFilter(FDeletionListRow& Row) const {return true;}
+	virtual void EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const;
+
+private:
+	bool bEnabled = false;
+	bool bDirty = true;
+	TBitArray<> Passes;
+};
+
+/** Rows of the selected asset classes only */
+class FDeletionListClassFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+
+	bool IsClassAllowed(FName ClassName) const {return AllowedClasses.Contains(ClassName);}
+	void ToggleClass(FName ClassName);
+
+protected:
+	virtual bool PassesFilter(FDeletionListRow& Row) const override;
+
+private:
+	TSet<FName> AllowedClasses;
+};
+
+/** Rows inside a sub-path of the current folder */
+class FDeletionListPathFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+
+	const FString& GetSubPath() const {return SubPath;}
+	void SetSubPath(const FString& InSubPath);
+
+protected:
+	virtual bool PassesFilter(FDeletionListRow& Row) const override;
+
+private:
+	FString SubPath;
+};
+
+/** Rows without any package referencers, using the referencer count cached on the row */
+class FDeletionListUnusedFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+
+protected:
+	virtual bool PassesFilter(FDeletionListRow& Row) const override;
+};
+
+/** Rows sharing their asset name with at least one other row */
+class FDeletionListDuplicateNameFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+	virtual bool DependsOnRowSet() const override {return true;}
+	virtual bool CanGroupRows() const override {return true;}
+	virtual void GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const override;
+
+protected:
+	virtual void EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const override;
+};
+
+/**
+ * Rows whose package payload is byte-identical to another row of the same class.
+ * Hashes come from the module's content hash cache, so only changed packages are read again
+ */
+class FDeletionListDuplicateContentFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+	virtual bool DependsOnRowSet() const override {return true;}
+	/** A cancelled hash pass isn't memoized, the next evaluation picks up the remaining packages */
+	virtual bool IsOutdated() const override {return bHashPassCancelled;}
+	virtual bool DependsOnPackageContent() const override {return true;}
+	virtual bool CanGroupRows() const override {return true;}
+	virtual void GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const override;
+
+protected:
+	virtual void EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const override;
+
+private:
+	/** Hash of each row from the last evaluation, keyed by RowId, so grouping doesn't hash again */
+	mutable TMap<int32, FAssetContentHash> RowHashes;
+	mutable bool bHashPassCancelled = false;
+};
+
+/**
+ * Textures that look alike, e.g. the same art re-exported at another resolution or compression.
+ * Rows are clustered by the Hamming distance of their perceptual hashes, see FTexturePerceptualHashCache
+ */
+class FDeletionListNearDuplicateTextureFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+	virtual bool DependsOnRowSet() const override {return true;}
+	/** A cancelled hash pass isn't memoized, the next evaluation picks up the remaining textures */
+	virtual bool IsOutdated() const override {return bHashPassCancelled;}
+	virtual bool DependsOnPackageContent() const override {return true;}
+	virtual bool CanGroupRows() const override {return true;}
+	virtual void GroupRows(const TArray<FDeletionListRowPtr>& FilteredRows, TArray<FDeletionListRowPtr>& OutGroupHeaders) const override;
+
+protected:
+	virtual void EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const override;
+
+private:
+	/** Cluster of each passing row from the last evaluation, keyed by RowId */
+	mutable TMap<int32, int32> RowClusterIds;
+	mutable bool bHashPassCancelled = false;
+};
+
+/** Rows whose package size on disk is inside [MinSizeKB, MaxSizeKB]. Unset bounds are open */
+class FDeletionListSizeFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+
+	TOptional<int32> GetMinSizeKB() const {return MinSizeKB;}
+	TOptional<int32> GetMaxSizeKB() const {return MaxSizeKB;}
+	void SetSizeRangeKB(TOptional<int32> InMinSizeKB, TOptional<int32> InMaxSizeKB);
+
+protected:
+	virtual bool PassesFilter(FDeletionListRow& Row) const override;
+
+private:
+	TOptional<int32> MinSizeKB;
+	TOptional<int32> MaxSizeKB;
+};
+
+/**
+ * Rows whose package file hasn't been written to for at least MinDaysUnmodified days.
+ * Days are counted up to the date of the last full evaluation, which is redone once the date changes
+ */
+class FDeletionListModifiedFilter : public FDeletionListFilter
+{
+public:
+	virtual FText GetDisplayName() const override;
+	virtual bool IsOutdated() const override;
+
+	int32 GetMinDaysUnmodified() const {return MinDaysUnmodified;}
+	void SetMinDaysUnmodified(int32 InMinDaysUnmodified);
+
+protected:
+	virtual bool PassesFilter(FDeletionListRow& Row) const override;
+	virtual void EvaluateRowSet(const TArray<FDeletionListRowPtr>& Rows, TBitArray<>& OutPasses) const override;
+
+private:
+	int32 MinDaysUnmodified = 30;
+	/** UTC date the memoized results were computed against, rows added later are compared to the same date */
+	mutable FDateTime ReferenceDate;
+};
+
+/**
+ * Combines the enabled filters as a lazy AND of their memoized pass bits.
+ * Toggling a filter or changing its parameters only re-evaluates that one filter.
+ */
+class FDeletionListFilterPipeline
+{
+public:
+	FDeletionListFilterPipeline();
+
+	const TArray<TSharedRef<FDeletionListFilter>>& GetFilters() const {return Filters;}
+	int32 GetNumEnabledFilters() const;
+
+	/** Set-based filters are invalidated, per-row results stay valid since they are keyed by RowId */
+	void OnRowsRemoved();
+
+	/** Filters depending on package content are invalidated after a listed package was saved or updated */
+	void OnPackagesChanged();
+
+	/** First enabled filter that groups its results, nullptr shows the rows as a flat list */
+	const FDeletionListFilter* GetGroupingFilter() const;
+
+	/** Fills OutFilteredRows with the rows passing every enabled filter, in the order of InRows */
+	void Apply(const TArray<FDeletionListRowPtr>& InRows, int32 NumRowIds, TArray<FDeletionListRowPtr>& OutFilteredRows);
+
+	TSharedRef<FDeletionListClassFilter> ClassFilter;
+	TSharedRef<FDeletionListPathFilter> PathFilter;
+	TSharedRef<FDeletionListUnusedFilter> UnusedFilter;
+	TSharedRef<FDeletionListDuplicateNameFilter> DuplicateNameFilter;
+	TSharedRef<FDeletionListDuplicateContentFilter> DuplicateContentFilter;
+	TSharedRef<FDeletionListNearDuplicateTextureFilter> NearDuplicateTextureFilter;
+	TSharedRef<FDeletionListSizeFilter> SizeFilter;
+	TSharedRef<FDeletionListModifiedFilter> ModifiedFilter;
+
+private:
+	TArray<TSharedRef<FDeletionListFilter>> Filters;
+};
@@ -0,0 +1,103 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class IAssetRegistry;
+
+/**
+ * A single entry of the advanced deletion list view.
+ * Sort keys are cached once when the row is built, so re-sorting never calls back into the asset registry.
+ */
+struct FDeletionListRow
+{
+	TSharedPtr<FAssetData> AssetData;
+
+	/** Stable id of the row for the lifetime of the tab, used to address per-row bit arrays */
+	int32 RowId = INDEX_NONE;
+
+	/** Lexical ranks of the class, name and path among all rows of the list (see BuildSortRanks) */
+	int32 ClassRank = 0;
+	int32 NameRank = 0;
+	int32 PathRank = 0;
+
+	/** Package size on disk in bytes, INDEX_NONE if the registry has no package data */
+	int64 DiskSize = INDEX_NONE;
+	int32 ReferencerCount = 0;
+
+	/** Check state of the row, kept here so it survives the row widget being scrolled out and regenerated */
+	bool bIsChecked = false;
+
+	/** Only set on group header rows, which have no asset data and are never stored, filtered or searched */
+	FText GroupLabel;
+	TArray<TSharedPtr<FDeletionListRow>> GroupChildren;
+
+	bool IsGroupHeader() const {return !AssetData.IsValid();}
+
+	/** Cell texts, formatted once per row instead of every time its widget is generated */
+	struct FDisplayTexts
+	{
+		FText Class;
+		FText Name;
+		FText Path;
+		FText DiskSize;
+		FText Referencers;
+	};
+
+	FName GetClassName() const {return AssetData->AssetClassPath.GetAssetName();}
+
+	/** Built on first use only, so rows that are never scrolled into view cost no text */
+	const FDisplayTexts& GetDisplayTexts();
+
+	/**
+	 * Last write time of the package file, FDateTime::MinValue() if it can't be found.
+	 * Resolved on first use only, as it touches the disk.
+	 */
+	const FDateTime& GetFileTimestamp();
+
+	/** Creates a row and caches the registry-backed sort keys (disk size, referencer count) */
+	static TSharedPtr<FDeletionListRow> Make(const TSharedPtr<FAssetData>& InAssetData, IAssetRegistry& AssetRegistry);
+
+	/** Ranks the unique class/name/path FNames once, so sorting compares integers instead of strings */
+	static void BuildSortRanks(const TArray<TSharedPtr<FDeletionListRow>>& Rows);
+
+	/** Creates the collapsible header of a group of rows, the label gets the member count appended */
+	static TSharedPtr<FDeletionListRow> MakeGroupHeader(const FText& InLabel, TArray<TSharedPtr<FDeletionListRow>>&& InChildren);
+
+private:
+	TOptional<FDateTime> FileTimestamp;
+	TOptional<FDisplayTexts> DisplayTexts;
+};
+
+typedef TSharedPtr<FDeletionListRow> FDeletionListRowPtr;
+
+/**
+ * Groups rows sharing the same key in a single pass, keeping the order of Rows inside and across groups.
+ * Only groups with more than one row are returned, GetKey can return any hashable type, e.g. an FName
+ */
+template<typename KeyGetterType>
+TArray<TArray<FDeletionListRowPtr>> GroupDuplicateRows(const TArray<FDeletionListRowPtr>& Rows, KeyGetterType GetKey)
+{
+	typedef typename TDecay<decltype(GetKey(DeclVal<const FDeletionListRow&>()))>::Type FKeyType;
+
+	TMap<FKeyType, int32> GroupIndexByKey;
+	GroupIndexByKey.Reserve(Rows.Num());
+	TArray<TArray<FDeletionListRowPtr>> Groups;
+
+	for (const FDeletionListRowPtr& Row : Rows)
+	{
+		int32& GroupIndex = GroupIndexByKey.FindOrAdd(GetKey(*Row), INDEX_NONE);
+
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = Groups.AddDefaulted();
+		}
+
+		Groups[GroupIndex].Add(Row);
+	}
+
+	Groups.RemoveAll([](const TArray<FDeletionListRowPtr>& Group) {return Group.Num() < 2;});
+	return Groups;
+}
@@ -3,60 +3,212 @@
 #pragma once 
 
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STreeView.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+#include "SlateWidgets/AssetSearchIndex.h"
+#include "SlateWidgets/AdvancedDeletionFilters.h"
+
+class FObjectPostSaveContext;
+
+struct FAssetDeletionResult;
+
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateDeletionListCell, FDeletionListRowPtr, const FName&);
+
+/** Multi-column row of the advanced deletion list. Cell construction is forwarded to the owning tab */
+class SAdvancedDeletionListRow : public SMultiColumnTableRow<FDeletionListRowPtr>
+{
+public:
+	SLATE_BEGIN_ARGS(SAdvancedDeletionListRow) {}
+	SLATE_ARGUMENT(FDeletionListRowPtr, RowData)
+	SLATE_EVENT(FOnGenerateDeletionListCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable);
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+private:
+	FDeletionListRowPtr RowData;
+	FOnGenerateDeletionListCell OnGenerateCell;
+};
 
 class SAdvancedDeletionTab : public SCompoundWidget
 {
 	SLATE_BEGIN_ARGS(SAdvancedDeletionTab) {}
 	// Input args are a key-value pair
 	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>, AssetsDataToStore)
+	/** Content folder the stored assets were listed from. Registry changes below it are mirrored into the list */
+	SLATE_ARGUMENT(FString, WatchedPath)
 	SLATE_END_ARGS()
 
 public:
 	// The default constructor for shareable defaults
 	SAdvancedDeletionTab();
+	virtual ~SAdvancedDeletionTab();
 	void Construct(const FArguments& InArgs);
 
 private:
-	TSharedPtr<STextBlock> ComboBoxTextBlock;
-	TSharedPtr<SListView<TSharedPtr<FAssetData>>> ConstructedList;
+	/** Drives the tab from the UdemyCourse.AdvancedDeletion.Benchmark automation test */
+	friend class FAdvancedDeletionBenchmark;
+
+	TSharedPtr<STreeView<FDeletionListRowPtr>> ConstructedList;
+	TSharedPtr<SHeaderRow> ConstructedHeaderRow;
 	//TSharedPtr<FAssetData> ClickedAssetData;
-	TArray<TSharedPtr<FAssetData>> StoredAssetsData;
-	/** .ListItemsSource() for SListView */
-	TArray<TSharedPtr<FAssetData>> DisplayedAssetsData;
+	TArray<FDeletionListRowPtr> StoredAssetsData;
+	/** Rows passing the enabled filters, in sorted order. The search text narrows these down further */
+	TArray<FDeletionListRowPtr> FilteredAssetsData;
+	/** .TreeItemsSource() for the tree view when the rows aren't grouped */
+	TArray<FDeletionListRowPtr> DisplayedAssetsData;
+	/** .TreeItemsSource() while a grouping filter is enabled, the children are the rows of DisplayedAssetsData */
+	TArray<FDeletionListRowPtr> DisplayedGroupHeaders;
 	TSharedPtr<TArray<FString>> ClickedRowAssets;
 	/** For passing the displayed data to the module for processing */
-	TArray<TSharedPtr<FAssetData>> StoredAssetsDataToDelete;
-	TArray<TSharedRef<SCheckBox>> ConstructedCheckBoxes;
-	TArray<TSharedPtr<FText>> ComboBoxSourceItems;
+	TArray<FDeletionListRowPtr> StoredAssetsDataToDelete;
+	/** Stackable filters, each one memoizes its own results per row */
+	FDeletionListFilterPipeline FilterPipeline;
+
+	/** Column currently used for sorting, NAME_None keeps the order of the asset registry */
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	/** Handed out to rows in creation order, see FDeletionListRow::RowId */
+	int32 NextRowId = 0;
+	/** Built once in Construct() over every stored row */
+	FAssetSearchIndex SearchIndex;
+	FString SearchText;
+	/** One bit per RowId, set when the row matches SearchText */
+	TBitArray<> SearchMatches;
+	/** Pending search, restarted on every keystroke so the list only refilters once typing pauses */
+	TSharedPtr<FActiveTimerHandle> SearchTimerHandle;
+	static constexpr float SearchDelaySeconds = 0.15f;
+	/** Pending Content Browser sync, restarted on every selection change so drag and shift selects sync once */
+	TSharedPtr<FActiveTimerHandle> SelectionSyncTimerHandle;
+	static constexpr float SelectionSyncDelaySeconds = 0.2f;
+
+	/** A registry event waiting to be applied to the stored rows */
+	struct FPendingRegistryChange
+	{
+		enum class EType : uint8 {Added, Removed, Renamed, Updated};
+
+		EType Type;
+		/** Unset for EType::Updated, the content filters are invalidated as a whole */
+		FAssetData AssetData;
+		/** Object path before the rename, only set for EType::Renamed */
+		FSoftObjectPath OldObjectPath;
+	};
+
+	FString WatchedPath;
+	/** Stored rows by object path, so registry events find their row without a linear search */
+	TMap<FSoftObjectPath, FDeletionListRowPtr> RowsByObjectPath;
+	/** RowIds unlisted by RemoveRowForAsset() that are still in the stored row arrays until the next flush */
+	TSet<int32> RemovedRowIds;
+	/** Events are queued and applied together on the next frame, a bulk import then costs one list update */
+	TArray<FPendingRegistryChange> PendingRegistryChanges;
+	TSharedPtr<FActiveTimerHandle> RegistryChangesTimerHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PackageSavedHandle;
+	/** Set when rows were added, the lexical ranks are only rebuilt once a sort actually needs them */
+	bool bSortRanksDirty = false;
+
+	/** The thumbnail column is optional, rows are taller while it's shown */
+	bool bShowThumbnails = false;
+	static constexpr float ThumbnailSize = 32.f;
 
 	/** Helper functions for readability and encapsulation of repetitive UI components */
-	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
-	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay);
-	TSharedRef<SButton> ConstructButtonForRow(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+	TSharedRef<ITableRow> OnGenerateRowForList(FDeletionListRowPtr RowToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> OnGenerateCellForList(FDeletionListRowPtr RowToDisplay, const FName& ColumnName);
+	TSharedRef<ITableRow> ConstructGroupHeaderRow(const FDeletionListRowPtr& GroupHeader, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetChildrenForList(FDeletionListRowPtr Row, TArray<FDeletionListRowPtr>& OutChildren);
+	TSharedRef<SCheckBox> ConstructCheckBox(const FDeletionListRowPtr& RowToDisplay);
+	TSharedRef<SWidget> ConstructThumbnail(const FDeletionListRowPtr& RowToDisplay);
+	TSharedRef<SButton> ConstructButtonForRow(const FDeletionListRowPtr& RowToDisplay);
 	TSharedRef<SButton> ConstructSelectAllButton();
 	TSharedRef<SButton> ConstructDeselectAllButton();
 	TSharedRef<SButton> ConstructDeleteSelectedButton();
+	TSharedRef<SButton> ConstructExportButton();
 	TSharedRef<STextBlock> ConstructRowText(const FText& ContentText, const FSlateFontInfo& ContentFont);
 	TSharedRef<STextBlock> ConstructButtonText(const FText& ContentText);
 	TSharedRef<STextBlock> ConstructCurrentPathText();
-	TSharedRef<SComboBox<TSharedPtr<FText>>> ConstructComboBox();
-	TSharedRef<SWidget> OnGenerateComboBoxContent(TSharedPtr<FText> SourceItem);
-	// Returns the same type as the list view in the SScrollBox of the slate code
-	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructList();
+	TSharedRef<SComboButton> ConstructFilterComboButton();
+	TSharedRef<SSearchBox> ConstructSearchBox();
+	TSharedRef<SWidget> MakeFilterMenu();
+	void MakeClassFilterSubMenu(FMenuBuilder& MenuBuilder);
+	void AddFilterToggleEntry(FMenuBuilder& MenuBuilder, TSharedRef<FDeletionListFilter> Filter, const FText& ToolTip);
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+	// Returns the same type as the list view in the slate code
+	TSharedRef<STreeView<FDeletionListRowPtr>> ConstructList();
 
-	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+	FReply OnDeleteButtonClicked(FDeletionListRowPtr ClickedRow);
 	FReply OnSelectAllButtonClicked();
 	FReply OnDeselectAllButtonClicked();
 	FReply OnDeleteSelectedButtonClicked();
+	/** Asks for a file and writes the displayed rows to it, in the displayed order */
+	FReply OnExportButtonClicked();
+	/** Drops the rows of the deleted assets once the background deletion is done */
+	void OnAssetDeletionFinished(const FAssetDeletionResult& DeletionResult);
+	bool CanDeleteSelected() const;
 
 	// This is a getter pure function, which only returns the expression within braces
 	FSlateFontInfo GetEmbossedTextFont() const { return FCoreStyle::Get().GetFontStyle(FName("EmbossedText")); }
 
-	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
-	void OnComboBoxSelectionChanged(TSharedPtr<FText> SelectedOption, ESelectInfo::Type InSelectInfo);
-	void OnAssetListViewSelectionChanged(TSharedPtr<FAssetData> SelectedItems, ESelectInfo::Type SelectInfo);
+	void OnCheckBoxStateChanged(ECheckBoxState NewState, FDeletionListRowPtr Row);
+	ECheckBoxState GetRowCheckState(FDeletionListRowPtr Row) const {return Row->bIsChecked ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;}
+	void ClearCheckedRows();
+	ECheckBoxState GetShowThumbnailsState() const;
+	void OnShowThumbnailsChanged(ECheckBoxState NewState);
+	FText GetFilterButtonText() const;
+	void ToggleFilter(TSharedRef<FDeletionListFilter> Filter);
+	bool IsFilterEnabled(TSharedRef<FDeletionListFilter> Filter) const {return Filter->IsEnabled();}
+	void ToggleClassFilter(FName ClassName);
+	bool IsClassFiltered(FName ClassName) const {return FilterPipeline.ClassFilter->IsClassAllowed(ClassName);}
+	void OnSubPathCommitted(const FText& InText, ETextCommit::Type InCommitType);
+	TOptional<int32> GetMinSizeKB() const {return FilterPipeline.SizeFilter->GetMinSizeKB();}
+	TOptional<int32> GetMaxSizeKB() const {return FilterPipeline.SizeFilter->GetMaxSizeKB();}
+	void OnMinSizeCommitted(int32 InValue, ETextCommit::Type InCommitType);
+	void OnMaxSizeCommitted(int32 InValue, ETextCommit::Type InCommitType);
+	int32 GetMinDaysUnmodified() const {return FilterPipeline.ModifiedFilter->GetMinDaysUnmodified();}
+	void OnMinDaysUnmodifiedCommitted(int32 InValue, ETextCommit::Type InCommitType);
+	/**
+	 * Re-runs the filter pipeline. Only dirty filters are re-evaluated, then the result is sorted.
+	 * bResetChecks = false keeps the checked rows, e.g. when only a few rows were patched in
+	 */
+	void ApplyFilters(bool bResetChecks = true);
+	void OnAssetListViewSelectionChanged(FDeletionListRowPtr SelectedItems, ESelectInfo::Type SelectInfo);
+	/** Syncs the Content Browser to the final selection, unless it's unchanged or above the configured size */
+	EActiveTimerReturnType OnSelectionSyncTimerElapsed(double InCurrentTime, float InDeltaTime);
+	void OnSearchTextChanged(const FText& InSearchText);
+	EActiveTimerReturnType OnSearchTimerElapsed(double InCurrentTime, float InDeltaTime);
+	/** Copies the filtered rows matching the search into DisplayedAssetsData. Keeps the sorted order */
+	void UpdateDisplayedRows(bool bResetChecks = true);
+
+	bool IsInWatchedPath(const FAssetData& AssetData) const;
+	bool IsInWatchedPath(const FString& PackagePath) const;
+	void OnRegistryAssetAdded(const FAssetData& AssetData);
+	void OnRegistryAssetRemoved(const FAssetData& AssetData);
+	void OnRegistryAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnRegistryAssetUpdated(const FAssetData& AssetData);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	void QueueRegistryChange(FPendingRegistryChange&& Change);
+	/** Patches the stored rows with the queued registry changes, without rebuilding the list */
+	EActiveTimerReturnType OnApplyRegistryChanges(double InCurrentTime, float InDeltaTime);
+	/** Creates, indexes and stores a row, returns nullptr if the asset is already listed */
+	FDeletionListRowPtr AddRowForAsset(const FAssetData& AssetData, IAssetRegistry& AssetRegistry);
+	/** Unlists the row of the asset, returns false if it wasn't listed. FlushRemovedRows() drops it from the stored rows */
+	bool RemoveRowForAsset(const FSoftObjectPath& ObjectPath);
+	/** Drops every row removed since the last flush from StoredAssetsData and StoredAssetsDataToDelete */
+	void FlushRemovedRows();
+
+	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode);
+	/** Sorts FilteredAssetsData by the cached integer keys of the current sort column */
+	void SortFilteredRows();
 	/** Wraps ConstructedList pointer in a valid check for abstraction(simplifies the code) */
-	void RefreshList();
+	void RefreshList(bool bResetChecks = true);
 
 };
 
@@ -0,0 +1,41 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+
+/**
+ * Case-insensitive text index over the asset names and package paths of the advanced deletion list.
+ * Built once when the tab opens, so each keystroke only touches the entries that can possibly match.
+ * Every query is a substring match. Queries up to a trigram long read their own n-gram postings directly,
+ * longer ones verify the rows of their rarest trigram.
+ */
+class FAssetSearchIndex
+{
+public:
+	/** Replaces the index contents with the given rows. Rows are addressed by their RowId */
+	void Build(const TArray<FDeletionListRowPtr>& Rows);
+
+	/** Indexes a single row that was added after Build() */
+	void AddRow(const FDeletionListRow& Row);
+
+	/**
+	 * Sets a bit per RowId for every row whose name or path matches the query.
+	 * Bits of removed rows may still be set, callers intersect the result with their live rows.
+	 */
+	void Query(const FString& InQuery, TBitArray<>& OutMatches) const;
+
+private:
+	static constexpr int32 TrigramLength = 3;
+
+	/** Lower-cased "name\npath" per RowId. The separator can't be typed into the search box */
+	TArray<FString> SearchKeys;
+	/** RowIds containing each unigram, bigram and trigram, in ascending order */
+	TMap<uint64, TArray<int32>> NGramPostings;
+
+	static FString MakeSearchKey(const FAssetData& AssetData);
+	static uint64 PackNGram(const TCHAR* Chars, int32 Length);
+
+	void IndexNGrams(int32 RowId);
+};
@@ -0,0 +1,94 @@
+// Copyright MODogma. All Rights Reserved.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
+
+class SWindow;
+
+/** One row of the review list, one string per column. Checked by default */
+struct FReviewListItem
+{
+	/** Index of the row in the array passed to SReviewListWindow::Open() */
+	int32 ItemIndex = INDEX_NONE;
+	TArray<FString> Columns;
+	bool bIsChecked = true;
+};
+
+typedef TSharedPtr<FReviewListItem> FReviewListItemPtr;
+
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateReviewListCell, FReviewListItemPtr, const FName&);
+
+class SReviewListRow : public SMultiColumnTableRow<FReviewListItemPtr>
+{
+public:
+	SLATE_BEGIN_ARGS(SReviewListRow) {}
+	SLATE_ARGUMENT(FReviewListItemPtr, Item)
+	SLATE_EVENT(FOnGenerateReviewListCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable);
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+private:
+	FReviewListItemPtr Item;
+	FOnGenerateReviewListCell OnGenerateCell;
+};
+
+/**
+ * Modal confirmation for large batches, a replacement for an FMessageDialog with every item joined into it.
+ * Rows have one or more labelled columns, e.g. a path, or a before and after name. The list is virtualized
+ * and filterable, and rows can be unticked before confirming.
+ */
+class SReviewListWindow : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SReviewListWindow) {}
+	SLATE_ARGUMENT(FText, Message)
+	SLATE_ARGUMENT(FText, ConfirmText)
+	SLATE_ARGUMENT(TArray<FText>, ColumnLabels)
+	/** One entry per row, each with one string per column label */
+	SLATE_ARGUMENT(TArray<TArray<FString>>, Rows)
+	SLATE_ARGUMENT(TWeakPtr<SWindow>, ParentWindow)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/**
+	 * Shows the window modally and blocks until it is closed. Returns the indices of the rows that were
+	 * still checked when the user confirmed, in ascending order, or an empty array if the window was cancelled
+	 */
+	static TArray<int32> Open(const FText& Title, const FText& Message, const FText& ConfirmText, const TArray<FText>& ColumnLabels, const TArray<TArray<FString>>& Rows);
+
+	/** Single column version, for lists of paths */
+	static TArray<int32> Open(const FText& Title, const FText& Message, const FText& ConfirmText, const FText& ColumnLabel, const TArray<FString>& Rows);
+
+private:
+	TArray<FReviewListItemPtr> AllItems;
+	/** .ListItemsSource() of the list, the items of AllItems with a column matching FilterText */
+	TArray<FReviewListItemPtr> DisplayedItems;
+	TSharedPtr<SListView<FReviewListItemPtr>> ConstructedList;
+	TWeakPtr<SWindow> ParentWindow;
+	FString FilterText;
+	int32 NumChecked = 0;
+	bool bConfirmed = false;
+
+	TSharedRef<SHeaderRow> ConstructHeaderRow(const TArray<FText>& ColumnLabels) const;
+	/** Column ids are "Column_1", "Column_2"..., so the number of the id is the index into the row's strings plus one */
+	static FName GetColumnId(int32 ColumnIndex) {return FName(TEXT("Column"), ColumnIndex + 1);}
+	TSharedRef<ITableRow> OnGenerateRowForList(FReviewListItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> OnGenerateCellForList(FReviewListItemPtr Item, const FName& ColumnName);
+	ECheckBoxState GetItemCheckState(FReviewListItemPtr Item) const {return Item->bIsChecked ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;}
+	void OnItemCheckStateChanged(ECheckBoxState NewState, FReviewListItemPtr Item);
+	void OnFilterTextChanged(const FText& InFilterText);
+	/** Checks or unchecks the displayed items only, so a filter can narrow down what gets toggled */
+	FReply OnSetDisplayedChecked(bool bChecked);
+	FReply OnConfirmClicked();
+	FReply OnCancelClicked();
+	FText GetCountText() const;
+	bool CanConfirm() const {return NumChecked > 0;}
+	void CloseWindow();
+};
@@ -4,6 +4,12 @@
 
 #include "Modules/ModuleManager.h"
 #include "SceneOutlinerModule.h"
+#include "SlateWidgets/AdvancedDeletionListRow.h"
+#include "ProcessData/AssetDeletionPipeline.h"
+#include "ProcessData/AssetContentHashCache.h"
+#include "ProcessData/TexturePerceptualHash.h"
+#include "ProcessData/NamingConvention.h"
+#include "ProcessData/AssetJobScheduler.h"
 
 class FUdemyCourseModule : public IModuleInterface
 {
@@ -77,6 +83,8 @@ private:
 	void OnDeleteUnusedAssetsButtonClicked();
 	void OnDeleteEmptyFoldersButtonClicked();
 	void OnAdvancedDeletionButtonClicked();
+	void OnRestoreQuarantineButtonClicked();
+	void OnPurgeQuarantineButtonClicked();
 	bool FixupRedirectors();
 	
 	// Edit conditions for menu entries
@@ -99,6 +107,13 @@ public:
 	void SyncCBToSelectedRows(const TArray<FString>& SelectedRowAssets);
 	/** Getter for passing data to the widget */
 	TArray<FString> GetSelectedPaths() {return SelectedPaths;}
+	/** Thumbnail pool shared by every list of the plugin, created on first use */
+	TSharedPtr<class FAssetThumbnailPool> GetThumbnailPool();
+
+private:
+	TSharedPtr<class FAssetThumbnailPool> ThumbnailPool;
+	/** Rendered thumbnails kept alive at once, older ones are evicted least recently used first */
+	static constexpr int32 ThumbnailPoolSize = 256;
 #pragma endregion
 
 public:
@@ -111,18 +126,50 @@ public:
 	 */
 	bool DeleteAssetFromWidget(const FAssetData& AssetData);
 
-	bool DeleteCheckedWidgetAssets(const TArray<FAssetData>& AssetsToDelete);
-	void GetUnusedAssetsForList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData);
+	/**
+	 * Hands every checked asset to the engine in a single delete, so references are gathered
+	 * and garbage is collected once for the whole batch instead of once per asset.
+	 * Moves them into the quarantine instead while quarantine mode is enabled
+	 */
+	FAssetDeletionResult DeleteCheckedWidgetAssets(const TArray<FAssetData>& AssetsToDelete);
+
+	/**
+	 * Deletes the assets in the background over several frames, see FAssetDeletionPipeline.
+	 * Returns false if a deletion is already running. In quarantine mode the assets are moved
+	 * right away instead and OnFinished is called before returning
+	 */
+	bool StartAssetDeletionPipeline(const TArray<FAssetData>& AssetsToDelete, FOnAssetDeletionFinished OnFinished);
+	bool IsAssetDeletionRunning() const {return ActiveDeletionPipeline.IsValid() && ActiveDeletionPipeline->IsRunning();}
 
 	/** 
 	 * The new Epic standard is to use package names instead for this reason, as duplicate
-	 * names sometimes occur an disparate assets. The better check would be resource size && asset class && asset name
+	 * names sometimes occur an disparate assets. See the Duplicate Content filter for the byte-level check.
+	 * Rows are returned group by group, linear in the number of rows
 	 */
-	void GetDuplicateNameAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutDuplicateNameAssetsData);
+	void GetDuplicateNameAssets(const TArray<FDeletionListRowPtr>& AssetsDataToFilter, TArray<FDeletionListRowPtr>& OutDuplicateNameAssetsData);
+
+	/** Package payload hashes, kept for the editor session so repeat duplicate content checks are cheap */
+	FAssetContentHashCache& GetContentHashCache() {return ContentHashCache;}
+	/** Perceptual texture hashes by source GUID, kept for the editor session */
+	FTexturePerceptualHashCache& GetTextureHashCache() {return TextureHashCache;}
+	/** Naming convention compiled from the plugin settings on first use, and again after they change */
+	FNamingConvention& GetNamingConvention();
+	/** Queue of the time-sliced bulk operations, created on first use */
+	FAssetJobScheduler& GetJobScheduler();
 
 	/** Returns false if there are no selected level actors */
 	bool IsLevelActorSelected();
 
 	TArray<AActor*> GetSelectedActors();
+
+private:
+	/** Only one background deletion at a time, kept until the next one starts */
+	TSharedPtr<FAssetDeletionPipeline> ActiveDeletionPipeline;
+	FAssetContentHashCache ContentHashCache;
+	FTexturePerceptualHashCache TextureHashCache;
+	TUniquePtr<FNamingConvention> NamingConvention;
+	TUniquePtr<FAssetJobScheduler> JobScheduler;
+	FDelegateHandle SettingsChangedHandle;
+	void OnSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
 #pragma endregion
 };
@@ -51,6 +51,10 @@ public class UdemyCourse : ModuleRules
 				"Slate",
 				"SlateCore",
 				"MaterialEditor",
+				"ImageCore",
+				"DesktopPlatform",
+				"DeveloperSettings",
+				"SourceControl",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);